@@ -0,0 +1,388 @@
+#ifndef CS564_PROJECT_FLAT_PAGE_MAP_HPP
+#define CS564_PROJECT_FLAT_PAGE_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Open-addressing hash map from page ID to page in the style of Swiss tables.
+ * Slots are split into groups of 16, each with a 16-byte array of control
+ * bytes. A control byte is empty, deleted, or holds 7 bits of the page ID's
+ * hash. A lookup compares all control bytes of a group with the hash bits at
+ * once, using SSE2 where available, and only reads the slots that match. Page
+ * IDs and pages are stored inline in the slots, so a hit usually touches one
+ * control group and one slot. It has the same interface as `PageIndex`.
+ * @tparam PageType Page type stored by the engine.
+ */
+template <typename PageType> class FlatPageMap {
+public:
+  /** Number of slots in a group. */
+  static constexpr size_t kGroupSize = 16;
+
+  /**
+   * Find a page.
+   * @param pageId Page ID.
+   * @return Pointer to the page, or a null pointer if it is not in the map.
+   */
+  [[nodiscard]] PageType *find(unsigned pageId) const;
+
+  /**
+   * Insert a page. Assumes no page with the same page ID is in the map.
+   * @param pageId Page ID.
+   * @param page Pointer to the page. Must not be null.
+   */
+  void insert(unsigned pageId, PageType *page);
+
+  /**
+   * Insert a page, replacing any page with the same page ID.
+   * @param pageId Page ID.
+   * @param page Pointer to the page. Must not be null.
+   * @return Pointer to the replaced page, or a null pointer if there was none.
+   */
+  PageType *exchange(unsigned pageId, PageType *page);
+
+  /**
+   * Remove a page.
+   * @param pageId Page ID.
+   * @return Pointer to the removed page, or a null pointer if there was none.
+   */
+  PageType *erase(unsigned pageId);
+
+  /**
+   * Remove all pages with page ID greater than or equal to `pageIdLimit`.
+   * @tparam Function Callable taking a `PageType *`.
+   * @param pageIdLimit Page ID limit.
+   * @param function Called on each page after it is removed.
+   */
+  template <typename Function>
+  void eraseFrom(unsigned pageIdLimit, Function function);
+
+  /**
+   * Call a function on every page, in no particular order.
+   * @tparam Function Callable taking a `PageType *`.
+   * @param function Called on each page. Must not modify the map.
+   */
+  template <typename Function> void forEach(Function function) const;
+
+  /**
+   * Get the number of pages in the map.
+   * @return Number of pages.
+   */
+  [[nodiscard]] size_t size() const;
+
+private:
+  /** Control byte of a slot that has never held a page. */
+  static constexpr int8_t kEmpty = -128;
+
+  /** Control byte of a slot whose page was erased. */
+  static constexpr int8_t kDeleted = -2;
+
+  struct Slot {
+    unsigned pageId;
+    PageType *page;
+  };
+
+  /**
+   * Bit mask over the slots of a group. Bit `i` is set if slot `i` matches.
+   */
+  using Mask = uint32_t;
+
+  /**
+   * Hash a page ID. The top 7 bits become the control byte and the bits below
+   * select the first group to probe.
+   * @param pageId Page ID.
+   * @return Hash.
+   */
+  static uint64_t hash(unsigned pageId);
+
+  /**
+   * Get the control byte for a hash.
+   * @param hash Hash of a page ID.
+   * @return Control byte, between 0 and 127.
+   */
+  static int8_t getTag(uint64_t hash);
+
+  /**
+   * Get the slots of a group whose control byte equals a value.
+   * @param group Pointer to the group's control bytes.
+   * @param value Control byte to compare with.
+   * @return Mask of matching slots.
+   */
+  static Mask match(const int8_t *group, int8_t value);
+
+  /**
+   * Get the slots of a group that are empty or deleted.
+   * @param group Pointer to the group's control bytes.
+   * @return Mask of matching slots.
+   */
+  static Mask matchEmptyOrDeleted(const int8_t *group);
+
+  /**
+   * Get the index of the lowest set bit of a non-zero mask.
+   * @param mask Mask.
+   * @return Bit index.
+   */
+  static unsigned lowestBit(Mask mask);
+
+  /**
+   * Find the slot holding a page ID.
+   * @param pageId Page ID.
+   * @return Slot index, or -1 if the page ID is not in the map.
+   */
+  [[nodiscard]] ptrdiff_t findSlot(unsigned pageId) const;
+
+  /**
+   * Find an empty or deleted slot for a page ID, which is not in the map. The
+   * table must have at least one group.
+   * @param hash Hash of the page ID.
+   * @return Slot index.
+   */
+  [[nodiscard]] size_t findFreeSlot(uint64_t hash) const;
+
+  /**
+   * Empty a slot holding a page.
+   * @param slotIndex Slot index.
+   */
+  void eraseSlot(size_t slotIndex);
+
+  /**
+   * Rebuild the table, doubling the number of groups if it is more than
+   * half full so deleted slots are reclaimed without growing needlessly.
+   */
+  void rehash();
+
+  /** Control bytes, `kGroupSize` per group. */
+  std::vector<int8_t> control_;
+
+  std::vector<Slot> slots_;
+
+  /** Number of groups minus one. The number of groups is a power of two. */
+  size_t groupMask_ = 0;
+
+  size_t size_ = 0;
+
+  /** Number of slots that may still receive a page before rehashing. */
+  size_t growthLeft_ = 0;
+};
+
+template <typename PageType>
+PageType *FlatPageMap<PageType>::find(unsigned pageId) const {
+  ptrdiff_t slotIndex = findSlot(pageId);
+  return slotIndex != -1 ? slots_[slotIndex].page : nullptr;
+}
+
+template <typename PageType>
+void FlatPageMap<PageType>::insert(unsigned pageId, PageType *page) {
+  exchange(pageId, page);
+}
+
+template <typename PageType>
+PageType *FlatPageMap<PageType>::exchange(unsigned pageId, PageType *page) {
+  // If the page ID is already in the map, replace its page.
+  ptrdiff_t slotIndex = findSlot(pageId);
+  if (slotIndex != -1) {
+    PageType *oldPage = slots_[slotIndex].page;
+    slots_[slotIndex].page = page;
+    return oldPage;
+  }
+
+  // Otherwise, claim an empty or deleted slot. Only claiming an empty slot
+  // uses up growth, since a deleted slot was already counted.
+  if (slots_.empty()) {
+    rehash();
+  }
+  uint64_t pageIdHash = hash(pageId);
+  size_t freeSlotIndex = findFreeSlot(pageIdHash);
+  if (control_[freeSlotIndex] == kEmpty && growthLeft_ == 0) {
+    rehash();
+    freeSlotIndex = findFreeSlot(pageIdHash);
+  }
+  if (control_[freeSlotIndex] == kEmpty) {
+    --growthLeft_;
+  }
+  control_[freeSlotIndex] = getTag(pageIdHash);
+  slots_[freeSlotIndex] = Slot{pageId, page};
+  ++size_;
+  return nullptr;
+}
+
+template <typename PageType>
+PageType *FlatPageMap<PageType>::erase(unsigned pageId) {
+  ptrdiff_t slotIndex = findSlot(pageId);
+  if (slotIndex == -1) {
+    return nullptr;
+  }
+  PageType *page = slots_[slotIndex].page;
+  eraseSlot(slotIndex);
+  return page;
+}
+
+template <typename PageType>
+template <typename Function>
+void FlatPageMap<PageType>::eraseFrom(unsigned pageIdLimit,
+                                      Function function) {
+  for (size_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex) {
+    if (control_[slotIndex] >= 0 && slots_[slotIndex].pageId >= pageIdLimit) {
+      PageType *page = slots_[slotIndex].page;
+      eraseSlot(slotIndex);
+      function(page);
+    }
+  }
+}
+
+template <typename PageType>
+template <typename Function>
+void FlatPageMap<PageType>::forEach(Function function) const {
+  for (size_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex) {
+    if (control_[slotIndex] >= 0) {
+      function(slots_[slotIndex].page);
+    }
+  }
+}
+
+template <typename PageType> size_t FlatPageMap<PageType>::size() const {
+  return size_;
+}
+
+template <typename PageType>
+uint64_t FlatPageMap<PageType>::hash(unsigned pageId) {
+  // Fibonacci hashing. The high bits of the product depend on every bit of the
+  // page ID, so both the control byte and the group are taken from them.
+  return (uint64_t)pageId * 0x9E3779B97F4A7C15ull;
+}
+
+template <typename PageType>
+int8_t FlatPageMap<PageType>::getTag(uint64_t hash) {
+  return (int8_t)(hash >> 57);
+}
+
+template <typename PageType>
+typename FlatPageMap<PageType>::Mask
+FlatPageMap<PageType>::match(const int8_t *group, int8_t value) {
+#if defined(__SSE2__)
+  __m128i control = _mm_loadu_si128((const __m128i *)group);
+  return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(value)));
+#else
+  Mask mask = 0;
+  for (size_t i = 0; i < kGroupSize; ++i) {
+    mask |= (Mask)(group[i] == value) << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename PageType>
+typename FlatPageMap<PageType>::Mask
+FlatPageMap<PageType>::matchEmptyOrDeleted(const int8_t *group) {
+  // Empty and deleted control bytes are the only negative ones.
+#if defined(__SSE2__)
+  return (Mask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+  Mask mask = 0;
+  for (size_t i = 0; i < kGroupSize; ++i) {
+    mask |= (Mask)(group[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename PageType>
+unsigned FlatPageMap<PageType>::lowestBit(Mask mask) {
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  unsigned bit = 0;
+  while ((mask & 1) == 0) {
+    mask >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+template <typename PageType>
+ptrdiff_t FlatPageMap<PageType>::findSlot(unsigned pageId) const {
+  if (size_ == 0) {
+    return -1;
+  }
+
+  // Probe groups quadratically, starting at the group chosen by the hash. The
+  // page ID is not in the map once a group with an empty slot is reached.
+  uint64_t pageIdHash = hash(pageId);
+  int8_t tag = getTag(pageIdHash);
+  size_t groupIndex = (size_t)(pageIdHash >> 25) & groupMask_;
+  for (size_t step = 1;; ++step) {
+    const int8_t *group = &control_[groupIndex * kGroupSize];
+    for (Mask mask = match(group, tag); mask != 0; mask &= mask - 1) {
+      size_t slotIndex = groupIndex * kGroupSize + lowestBit(mask);
+      if (slots_[slotIndex].pageId == pageId) {
+        return (ptrdiff_t)slotIndex;
+      }
+    }
+    if (match(group, kEmpty) != 0) {
+      return -1;
+    }
+    groupIndex = (groupIndex + step) & groupMask_;
+  }
+}
+
+template <typename PageType>
+size_t FlatPageMap<PageType>::findFreeSlot(uint64_t hash) const {
+  size_t groupIndex = (size_t)(hash >> 25) & groupMask_;
+  for (size_t step = 1;; ++step) {
+    Mask mask = matchEmptyOrDeleted(&control_[groupIndex * kGroupSize]);
+    if (mask != 0) {
+      return groupIndex * kGroupSize + lowestBit(mask);
+    }
+    groupIndex = (groupIndex + step) & groupMask_;
+  }
+}
+
+template <typename PageType>
+void FlatPageMap<PageType>::eraseSlot(size_t slotIndex) {
+  // Groups are probed whole, so if the slot's group still has an empty slot,
+  // no probe continues past it and the slot can become empty again.
+  // Otherwise, leave a deleted marker so later probes keep going.
+  const int8_t *group = &control_[slotIndex / kGroupSize * kGroupSize];
+  if (match(group, kEmpty) != 0) {
+    control_[slotIndex] = kEmpty;
+    ++growthLeft_;
+  } else {
+    control_[slotIndex] = kDeleted;
+  }
+  --size_;
+}
+
+template <typename PageType> void FlatPageMap<PageType>::rehash() {
+  // Keep the table at most 7/8 full, counting deleted slots.
+  size_t numGroups = slots_.size() / kGroupSize;
+  if (numGroups == 0) {
+    numGroups = 1;
+  } else if (size_ * 2 >= slots_.size() * 7 / 8) {
+    numGroups *= 2;
+  }
+
+  std::vector<int8_t> oldControl(numGroups * kGroupSize, kEmpty);
+  std::vector<Slot> oldSlots(numGroups * kGroupSize);
+  oldControl.swap(control_);
+  oldSlots.swap(slots_);
+  groupMask_ = numGroups - 1;
+  growthLeft_ = slots_.size() * 7 / 8 - size_;
+
+  // Move each page into the new table.
+  for (size_t slotIndex = 0; slotIndex < oldSlots.size(); ++slotIndex) {
+    if (oldControl[slotIndex] >= 0) {
+      uint64_t pageIdHash = hash(oldSlots[slotIndex].pageId);
+      size_t newSlotIndex = findFreeSlot(pageIdHash);
+      control_[newSlotIndex] = oldControl[slotIndex];
+      slots_[newSlotIndex] = oldSlots[slotIndex];
+    }
+  }
+}
+
+#endif // CS564_PROJECT_FLAT_PAGE_MAP_HPP
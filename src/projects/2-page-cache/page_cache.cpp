@@ -14,10 +14,34 @@ Page::~Page() {
   free(pExtra);
 }
 
+void *Page::getBuffer() const { return pBuf; }
+
 PageCache::PageCache(int pageSize, int extraSize)
     : pageSize_(pageSize), extraSize_(extraSize), maxNumPages_(0),
-      numFetches_(0), numHits_(0) {}
+      numFetches_(0), numHits_(0),
+      protectInteriorPages_(false) {}
 
 unsigned long long PageCache::getNumFetches() const { return numFetches_; }
 
 unsigned long long PageCache::getNumHits() const { return numHits_; }
+
+void PageCache::setProtectInteriorPages(bool protectInteriorPages) {
+  protectInteriorPages_ = protectInteriorPages;
+}
+
+bool PageCache::getProtectInteriorPages() const {
+  return protectInteriorPages_;
+}
+
+bool PageCache::isProtectedPage(const Page *page, unsigned pageId) const {
+  if (!protectInteriorPages_) {
+    return false;
+  }
+
+  int offset = pageId == 1 ? 100 : 0;
+  if (offset >= pageSize_) {
+    return false;
+  }
+  auto pageType = ((const unsigned char *)page->getBuffer())[offset];
+  return pageType == 0x02 || pageType == 0x05;
+}
@@ -17,6 +17,12 @@ public:
 
   ~Page();
 
+  /**
+   * Get the page's buffer, which holds the database page written by SQLite.
+   * @return Pointer to the buffer.
+   */
+  [[nodiscard]] void *getBuffer() const;
+
 private:
   void *pBufInner_;
 };
@@ -107,7 +113,35 @@ public:
    */
   [[nodiscard]] unsigned long long getNumHits() const;
 
+  /**
+   * Set whether B-tree interior pages are replaced only after all other
+   * unpinned pages. Every engine classifies a page with `isProtectedPage` when
+   * it is unpinned, and keeps protected pages apart from the pages it replaces
+   * first. Pages unpinned before the call keep their classification.
+   * @param protectInteriorPages Protect interior pages.
+   */
+  void setProtectInteriorPages(bool protectInteriorPages);
+
+  /**
+   * Get whether B-tree interior pages are replaced only after all other
+   * unpinned pages.
+   * @return True if interior pages are protected.
+   */
+  [[nodiscard]] bool getProtectInteriorPages() const;
+
 protected:
+  /**
+   * Check whether a page should be replaced only after all other unpinned
+   * pages. This is the case if interior pages are protected and the page's
+   * B-tree page-type byte marks it as an interior index page (0x02) or an
+   * interior table page (0x05). The byte is at offset 100 on page 1, after the
+   * database header, and at offset 0 on all other pages.
+   * @param page Pointer to a page.
+   * @param pageId Page ID.
+   * @return True if the page is protected.
+   */
+  [[nodiscard]] bool isProtectedPage(const Page *page, unsigned pageId) const;
+
   /** Maximum number of pages in the cache. */
   int maxNumPages_;
 
@@ -122,9 +156,18 @@ protected:
 
   /** Number of hits since creation. */
   unsigned long long numHits_;
+
+  /** Whether B-tree interior pages are replaced last. */
+  bool protectInteriorPages_;
 };
 
-template <typename PageCacheImplementation>
+/**
+ * SQLite page cache methods backed by a page cache implementation.
+ * @tparam PageCacheImplementation Page cache implementation.
+ * @tparam protectInteriorPages Whether the page caches SQLite creates protect
+ * B-tree interior pages.
+ */
+template <typename PageCacheImplementation, bool protectInteriorPages = false>
 struct PageCacheMethods : sqlite3_pcache_methods2 {
   explicit PageCacheMethods() : sqlite3_pcache_methods2() {
     xInit = [](void *) { return SQLITE_OK; };
@@ -132,7 +175,9 @@ struct PageCacheMethods : sqlite3_pcache_methods2 {
     xShutdown = nullptr;
 
     xCreate = [](int pageSize, int extraSize, int) {
-      return (sqlite3_pcache *)new PageCacheImplementation(pageSize, extraSize);
+      auto pageCache = new PageCacheImplementation(pageSize, extraSize);
+      pageCache->setProtectInteriorPages(protectInteriorPages);
+      return (sqlite3_pcache *)pageCache;
     };
 
     xCachesize = [](sqlite3_pcache *pageCacheBase, int maxNumPages) {
@@ -0,0 +1,282 @@
+#include "page_cache_2q.hpp"
+
+#include <algorithm>
+
+TwoQReplacementPageCache::TwoQReplacementPage::TwoQReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId, Queue argQueue)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      queue(argQueue), interior(false), prev(nullptr), next(nullptr) {}
+
+void TwoQReplacementPageCache::PageList::pushBack(TwoQReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+  ++size;
+}
+
+void TwoQReplacementPageCache::PageList::remove(TwoQReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  --size;
+}
+
+TwoQReplacementPageCache::TwoQReplacementPageCache(int pageSize, int extraSize,
+                                                   double inFraction,
+                                                   double outFraction)
+    : PageCache(pageSize, extraSize), inFraction_(inFraction),
+      outFraction_(outFraction) {}
+
+TwoQReplacementPageCache::~TwoQReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void TwoQReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  TwoQReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    pages_.erase(page->pageId);
+    delete page;
+  }
+
+  // Shrink A1out to its new target size.
+  while ((int)out_.size() > getOutTarget()) {
+    outIndex_.erase(out_.back());
+    out_.pop_back();
+  }
+}
+
+int TwoQReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
+Page *TwoQReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. A page
+  // in Am leaves the LRU list while pinned. A page in A1in keeps its place.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    TwoQReplacementPage *page = pagesIterator->second;
+    if (!page->pinned && page->queue == Queue::Am) {
+      removeFromQueue(page);
+    }
+    page->pinned = true;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  TwoQReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new TwoQReplacementPage(pageSize_, extraSize_, pageId, Queue::A1in);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    pages_.erase(page->pageId);
+    page->pageId = pageId;
+    page->pinned = true;
+    page->interior = false;
+  }
+  pages_.emplace(pageId, page);
+
+  // A page whose ID is in A1out was referenced again after leaving A1in, so it
+  // goes to Am when unpinned. Other pages enter A1in.
+  if (forgetOut(pageId)) {
+    page->queue = Queue::Am;
+  } else {
+    page->queue = Queue::A1in;
+    in_.pushBack(page);
+  }
+  return page;
+}
+
+void TwoQReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (TwoQReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. A page in Am becomes its most recently unpinned
+  // page. SQLite has written the page by now, so classify it by its page-type
+  // byte. A page in A1in keeps its place unless it changes lists.
+  bool interior = isProtectedPage(page, page->pageId);
+  if (page->queue == Queue::Am) {
+    if (!page->pinned) {
+      removeFromQueue(page);
+    }
+    page->interior = interior;
+    (interior ? interiorMain_ : main_).pushBack(page);
+  } else if (page->interior != interior) {
+    removeFromQueue(page);
+    page->interior = interior;
+    (interior ? interiorIn_ : in_).pushBack(page);
+  }
+  page->pinned = false;
+}
+
+void TwoQReplacementPageCache::changePageId(Page *pageBase,
+                                            unsigned newPageId) {
+  auto *page = (TwoQReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  forgetOut(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    removeFromQueue(pagesIterator->second);
+    delete pagesIterator->second;
+    pagesIterator->second = page;
+  }
+}
+
+void TwoQReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    TwoQReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromQueue(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so forget them in A1out as well.
+  for (auto outIterator = out_.begin(); outIterator != out_.end();) {
+    if (*outIterator >= pageIdLimit) {
+      outIndex_.erase(*outIterator);
+      outIterator = out_.erase(outIterator);
+    } else {
+      ++outIterator;
+    }
+  }
+}
+
+TwoQReplacementPageCache::TwoQReplacementPage *
+TwoQReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  TwoQReplacementPage *page = choosePage(in_, main_);
+  if (page == nullptr) {
+    page = choosePage(interiorIn_, interiorMain_);
+  }
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  if (page->queue == Queue::A1in) {
+    rememberOut(page->pageId);
+  }
+  removeFromQueue(page);
+  return page;
+}
+
+TwoQReplacementPageCache::TwoQReplacementPage *
+TwoQReplacementPageCache::choosePage(const PageList &in,
+                                     const PageList &main) const {
+  TwoQReplacementPage *page = nullptr;
+  if (in_.size + interiorIn_.size > getInTarget()) {
+    page = getOldestUnpinnedIn(in);
+  }
+  if (page == nullptr) {
+    page = main.head;
+  }
+  if (page == nullptr) {
+    page = getOldestUnpinnedIn(in);
+  }
+  return page;
+}
+
+TwoQReplacementPageCache::TwoQReplacementPage *
+TwoQReplacementPageCache::getOldestUnpinnedIn(const PageList &in) const {
+  for (TwoQReplacementPage *page = in.head; page != nullptr;
+       page = page->next) {
+    if (!page->pinned) {
+      return page;
+    }
+  }
+  return nullptr;
+}
+
+void TwoQReplacementPageCache::rememberOut(unsigned pageId) {
+  if (getOutTarget() == 0) {
+    return;
+  }
+
+  out_.push_front(pageId);
+  outIndex_[pageId] = out_.begin();
+  while ((int)out_.size() > getOutTarget()) {
+    outIndex_.erase(out_.back());
+    out_.pop_back();
+  }
+}
+
+bool TwoQReplacementPageCache::forgetOut(unsigned pageId) {
+  auto outIndexIterator = outIndex_.find(pageId);
+  if (outIndexIterator == outIndex_.end()) {
+    return false;
+  }
+
+  out_.erase(outIndexIterator->second);
+  outIndex_.erase(outIndexIterator);
+  return true;
+}
+
+void TwoQReplacementPageCache::removeFromQueue(TwoQReplacementPage *page) {
+  if (page->queue == Queue::A1in) {
+    (page->interior ? interiorIn_ : in_).remove(page);
+  } else if (!page->pinned) {
+    (page->interior ? interiorMain_ : main_).remove(page);
+  }
+}
+
+void TwoQReplacementPageCache::discardPage(TwoQReplacementPage *page) {
+  removeFromQueue(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+int TwoQReplacementPageCache::getInTarget() const {
+  return std::max(1, (int)(inFraction_ * maxNumPages_));
+}
+
+int TwoQReplacementPageCache::getOutTarget() const {
+  return (int)(outFraction_ * maxNumPages_);
+}
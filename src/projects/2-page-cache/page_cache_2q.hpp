@@ -0,0 +1,156 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_2Q_HPP
+#define CS564_PROJECT_PAGE_CACHE_2Q_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+
+/**
+ * Full 2Q page cache as described by Johnson and Shasha. New pages enter the
+ * FIFO queue A1in. Pages replaced from A1in leave their page IDs in the ghost
+ * queue A1out, and a page fetched while its ID is in A1out enters the LRU queue
+ * Am, which is ordered by unpin time.
+ */
+class TwoQReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct a TwoQReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param inFraction Size of A1in as a fraction of the maximum number of
+   * pages.
+   * @param outFraction Size of A1out as a fraction of the maximum number of
+   * pages.
+   */
+  TwoQReplacementPageCache(int pageSize, int extraSize,
+                           double inFraction = 0.25, double outFraction = 0.5);
+
+  ~TwoQReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  enum class Queue { A1in, Am };
+
+  struct TwoQReplacementPage : public Page {
+    TwoQReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                        Queue queue);
+
+    unsigned pageId;
+    bool pinned;
+    Queue queue;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Protected pages are kept in a separate list per queue.
+     */
+    bool interior;
+
+    /** Neighbors in the list of the page's queue. */
+    TwoQReplacementPage *prev;
+    TwoQReplacementPage *next;
+  };
+
+  struct PageList {
+    TwoQReplacementPage *head = nullptr;
+    TwoQReplacementPage *tail = nullptr;
+    int size = 0;
+
+    void pushBack(TwoQReplacementPage *page);
+    void remove(TwoQReplacementPage *page);
+  };
+
+  /**
+   * Choose a page to replace. The oldest unpinned page in A1in is chosen if
+   * A1in is over its target size, and its page ID is remembered in A1out.
+   * Otherwise, the least recently unpinned page in Am is chosen. Protected
+   * interior pages are chosen the same way, but only if no other page is
+   * unpinned.
+   * @return Pointer to a page, removed from its queue. Null if all pages are
+   * pinned.
+   */
+  TwoQReplacementPage *replacePage();
+
+  /**
+   * Choose a page to replace from one list of A1in and one list of Am.
+   * @param in List of A1in.
+   * @param main List of Am.
+   * @return Pointer to a page. Null if all pages in both lists are pinned.
+   */
+  [[nodiscard]] TwoQReplacementPage *choosePage(const PageList &in,
+                                                const PageList &main) const;
+
+  /**
+   * Get the oldest unpinned page in a list of A1in. Pinned pages keep their
+   * place in the FIFO and are skipped.
+   * @param in List of A1in.
+   * @return Pointer to a page. Null if all pages in the list are pinned.
+   */
+  [[nodiscard]] TwoQReplacementPage *
+  getOldestUnpinnedIn(const PageList &in) const;
+
+  /**
+   * Remember a replaced page ID in A1out, dropping the oldest IDs beyond its
+   * target size.
+   * @param pageId Page ID.
+   */
+  void rememberOut(unsigned pageId);
+
+  /**
+   * Forget a page ID in A1out, if present.
+   * @param pageId Page ID.
+   * @return True if the page ID was in A1out.
+   */
+  bool forgetOut(unsigned pageId);
+
+  /**
+   * Remove a page from its queue.
+   * @param page Pointer to a page.
+   */
+  void removeFromQueue(TwoQReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(TwoQReplacementPage *page);
+
+  [[nodiscard]] int getInTarget() const;
+
+  [[nodiscard]] int getOutTarget() const;
+
+  std::unordered_map<unsigned, TwoQReplacementPage *> pages_;
+
+  /** FIFO of pages seen once, pinned or not. */
+  PageList in_;
+
+  /** LRU of unpinned pages seen again after leaving A1in. */
+  PageList main_;
+
+  /**
+   * Protected interior pages of A1in and Am, kept in separate lists. Empty
+   * unless interior pages are protected.
+   */
+  PageList interiorIn_;
+  PageList interiorMain_;
+
+  /** Page IDs replaced from A1in, most recent first. */
+  std::list<unsigned> out_;
+  std::unordered_map<unsigned, std::list<unsigned>::iterator> outIndex_;
+
+  double inFraction_;
+  double outFraction_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_2Q_HPP
@@ -0,0 +1,295 @@
+#include "page_cache_arc.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+ARCReplacementPageCache::ARCReplacementPage::ARCReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      list(List::T1), interior(false), prev(nullptr), next(nullptr) {}
+
+void ARCReplacementPageCache::PageList::pushBack(ARCReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void ARCReplacementPageCache::PageList::remove(ARCReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+ARCReplacementPageCache::ARCReplacementPageCache(int pageSize, int extraSize)
+    : PageCache(pageSize, extraSize), t1Size_(0), t2Size_(0), p_(0) {}
+
+ARCReplacementPageCache::~ARCReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void ARCReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+  p_ = std::min(p_, std::max(maxNumPages_, 0));
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  ARCReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage(false)) != nullptr) {
+    pages_.erase(page->pageId);
+    delete page;
+  }
+
+  // The ghost lists are bounded relative to the new cache size.
+  trimGhosts();
+}
+
+int ARCReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
+Page *ARCReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. The
+  // page has now been seen at least twice, so it belongs to T2.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    ARCReplacementPage *page = pagesIterator->second;
+    removeFromList(page);
+    page->list = List::T2;
+    ++t2Size_;
+    page->pinned = true;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // A hit in B1 means T1 was too small, and a hit in B2 means T2 was too
+  // small. Adapt the target size of T1 accordingly.
+  auto ghostsIterator = ghosts_.find(pageId);
+  bool inB1 = ghostsIterator != ghosts_.end() &&
+              ghostsIterator->second.list == List::B1;
+  bool inB2 = ghostsIterator != ghosts_.end() &&
+              ghostsIterator->second.list == List::B2;
+  if (inB1) {
+    int delta = std::max((int)b2_.size() / (int)b1_.size(), 1);
+    p_ = std::min(p_ + delta, maxNumPages_);
+  } else if (inB2) {
+    int delta = std::max((int)b1_.size() / (int)b2_.size(), 1);
+    p_ = std::max(p_ - delta, 0);
+  }
+
+  // Allocate a new page if the number of pages in the cache is less than the
+  // maximum. Otherwise, replace an existing unpinned page. If all pages are
+  // pinned, return a null pointer.
+  ARCReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new ARCReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage(inB2);
+    if (page == nullptr) {
+      return nullptr;
+    }
+    pages_.erase(page->pageId);
+    page->pageId = pageId;
+    page->pinned = true;
+  }
+  pages_.emplace(pageId, page);
+
+  // A page found in a ghost list has been seen before, so it enters T2.
+  // Otherwise, it enters T1.
+  if (inB1 || inB2) {
+    eraseGhost(pageId);
+    page->list = List::T2;
+    ++t2Size_;
+  } else {
+    page->list = List::T1;
+    ++t1Size_;
+  }
+  trimGhosts();
+  return page;
+}
+
+void ARCReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (ARCReplacementPage *)pageBase;
+
+  // If discard is true, discard the page. If the number of pages in the cache
+  // is greater than the maximum, replace the page, remembering it in a ghost
+  // list.
+  if (discard) {
+    discardPage(page);
+    return;
+  }
+  if (getNumPages() > maxNumPages_) {
+    unsigned pageId = page->pageId;
+    List list = page->list == List::T1 ? List::B1 : List::B2;
+    discardPage(page);
+    pushGhost(pageId, list);
+    trimGhosts();
+    return;
+  }
+
+  // Otherwise, unpin the page and make it the most recently unpinned page of
+  // its list. SQLite has written the page by now, so classify it by its
+  // page-type byte.
+  if (!page->pinned) {
+    getPageList(page).remove(page);
+  }
+  page->pinned = false;
+  page->interior = isProtectedPage(page, page->pageId);
+  getPageList(page).pushBack(page);
+}
+
+void ARCReplacementPageCache::changePageId(Page *pageBase, unsigned newPageId) {
+  auto *page = (ARCReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  eraseGhost(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    removeFromList(pagesIterator->second);
+    delete pagesIterator->second;
+    pagesIterator->second = page;
+  }
+}
+
+void ARCReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    ARCReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromList(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so forget their ghosts as well.
+  for (auto ghostsIterator = ghosts_.begin();
+       ghostsIterator != ghosts_.end();) {
+    if (ghostsIterator->first >= pageIdLimit) {
+      auto &ghostList = ghostsIterator->second.list == List::B1 ? b1_ : b2_;
+      ghostList.erase(ghostsIterator->second.iterator);
+      ghostsIterator = ghosts_.erase(ghostsIterator);
+    } else {
+      ++ghostsIterator;
+    }
+  }
+}
+
+ARCReplacementPageCache::ARCReplacementPage *
+ARCReplacementPageCache::replacePage(bool inB2) {
+  bool preferT1 = t1Size_ >= 1 && ((inB2 && t1Size_ == p_) || t1Size_ > p_);
+  const PageList &preferred = preferT1 ? t1_ : t2_;
+  const PageList &other = preferT1 ? t2_ : t1_;
+  const PageList &interiorPreferred = preferT1 ? interiorT1_ : interiorT2_;
+  const PageList &interiorOther = preferT1 ? interiorT2_ : interiorT1_;
+
+  // Protected interior pages are only replaced if no other page is unpinned.
+  ARCReplacementPage *page = preferred.head;
+  if (page == nullptr) {
+    page = other.head;
+  }
+  if (page == nullptr) {
+    page = interiorPreferred.head;
+  }
+  if (page == nullptr) {
+    page = interiorOther.head;
+  }
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  removeFromList(page);
+  pushGhost(page->pageId, page->list == List::T1 ? List::B1 : List::B2);
+  return page;
+}
+
+void ARCReplacementPageCache::pushGhost(unsigned pageId, List list) {
+  auto &ghostList = list == List::B1 ? b1_ : b2_;
+  ghostList.push_back(pageId);
+  ghosts_[pageId] = {list, std::prev(ghostList.end())};
+}
+
+void ARCReplacementPageCache::eraseGhost(unsigned pageId) {
+  auto ghostsIterator = ghosts_.find(pageId);
+  if (ghostsIterator == ghosts_.end()) {
+    return;
+  }
+
+  auto &ghostList = ghostsIterator->second.list == List::B1 ? b1_ : b2_;
+  ghostList.erase(ghostsIterator->second.iterator);
+  ghosts_.erase(ghostsIterator);
+}
+
+void ARCReplacementPageCache::trimGhosts() {
+  int maxNumPages = std::max(maxNumPages_, 0);
+  while (!b1_.empty() && t1Size_ + (int)b1_.size() > maxNumPages) {
+    ghosts_.erase(b1_.front());
+    b1_.pop_front();
+  }
+  while (!b2_.empty() && t1Size_ + t2Size_ + (int)b1_.size() +
+                                 (int)b2_.size() >
+                             2 * maxNumPages) {
+    ghosts_.erase(b2_.front());
+    b2_.pop_front();
+  }
+  while (!b1_.empty() && t1Size_ + t2Size_ + (int)b1_.size() +
+                                 (int)b2_.size() >
+                             2 * maxNumPages) {
+    ghosts_.erase(b1_.front());
+    b1_.pop_front();
+  }
+}
+
+void ARCReplacementPageCache::removeFromList(ARCReplacementPage *page) {
+  if (!page->pinned) {
+    getPageList(page).remove(page);
+  }
+  if (page->list == List::T1) {
+    --t1Size_;
+  } else {
+    --t2Size_;
+  }
+}
+
+ARCReplacementPageCache::PageList &
+ARCReplacementPageCache::getPageList(ARCReplacementPage *page) {
+  if (page->list == List::T1) {
+    return page->interior ? interiorT1_ : t1_;
+  }
+  return page->interior ? interiorT2_ : t2_;
+}
+
+void ARCReplacementPageCache::discardPage(ARCReplacementPage *page) {
+  removeFromList(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
@@ -0,0 +1,146 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_ARC_HPP
+#define CS564_PROJECT_PAGE_CACHE_ARC_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+
+/**
+ * Adaptive Replacement Cache as described by Megiddo and Modha. Resident
+ * pages seen once are in T1 and pages seen again are in T2, both ordered by
+ * unpin time. The ghost lists B1 and B2 hold page IDs recently replaced from
+ * T1 and T2. A fetch that hits B1 grows the target size `p` of T1, and a fetch
+ * that hits B2 shrinks it.
+ */
+class ARCReplacementPageCache : public PageCache {
+public:
+  ARCReplacementPageCache(int pageSize, int extraSize);
+
+  ~ARCReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  enum class List { T1, T2, B1, B2 };
+
+  struct ARCReplacementPage : public Page {
+    ARCReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** T1 or T2. */
+    List list;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Protected pages are kept in separate lists.
+     */
+    bool interior;
+
+    /** Neighbors in the list of unpinned pages of `list`. */
+    ARCReplacementPage *prev;
+    ARCReplacementPage *next;
+  };
+
+  struct PageList {
+    ARCReplacementPage *head = nullptr;
+    ARCReplacementPage *tail = nullptr;
+
+    void pushBack(ARCReplacementPage *page);
+    void remove(ARCReplacementPage *page);
+  };
+
+  struct Ghost {
+    List list;
+    std::list<unsigned>::iterator iterator;
+  };
+
+  /**
+   * Choose a page to replace following ARC's REPLACE subroutine, and remember
+   * its page ID in B1 or B2. If the preferred list has no unpinned page, the
+   * other list is used. Protected interior pages are chosen the same way, but
+   * only if no other page is unpinned.
+   * @param inB2 True if the page being fetched was found in B2.
+   * @return Pointer to a page, removed from its list. Null if all pages are
+   * pinned.
+   */
+  ARCReplacementPage *replacePage(bool inB2);
+
+  /**
+   * Add a page ID at the most recent end of a ghost list.
+   * @param pageId Page ID.
+   * @param list B1 or B2.
+   */
+  void pushGhost(unsigned pageId, List list);
+
+  /**
+   * Remove a page ID from the ghost lists, if present.
+   * @param pageId Page ID.
+   */
+  void eraseGhost(unsigned pageId);
+
+  /**
+   * Drop the oldest ghost page IDs until |T1| + |B1| <= c and
+   * |T1| + |T2| + |B1| + |B2| <= 2c.
+   */
+  void trimGhosts();
+
+  /**
+   * Remove a page from its list of unpinned pages, if it is unpinned, and
+   * from the count of its list.
+   * @param page Pointer to a page.
+   */
+  void removeFromList(ARCReplacementPage *page);
+
+  /**
+   * Get the list of unpinned pages a page belongs in.
+   * @param page Pointer to a page.
+   * @return List of the page's list and classification.
+   */
+  PageList &getPageList(ARCReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(ARCReplacementPage *page);
+
+  std::unordered_map<unsigned, ARCReplacementPage *> pages_;
+
+  /** Unpinned pages of T1 and T2, least recently unpinned first. */
+  PageList t1_;
+  PageList t2_;
+
+  /**
+   * Unpinned protected interior pages of T1 and T2, kept in separate lists.
+   * Empty unless interior pages are protected.
+   */
+  PageList interiorT1_;
+  PageList interiorT2_;
+
+  /** Number of pages in T1 and T2, pinned or not. */
+  int t1Size_;
+  int t2Size_;
+
+  /** Ghost page IDs, least recently replaced first. */
+  std::list<unsigned> b1_;
+  std::list<unsigned> b2_;
+  std::unordered_map<unsigned, Ghost> ghosts_;
+
+  /** Target size of T1. */
+  int p_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_ARC_HPP
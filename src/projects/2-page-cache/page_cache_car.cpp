@@ -0,0 +1,362 @@
+#include "page_cache_car.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+CARReplacementPageCache::CARReplacementPage::CARReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      referenced(false), list(List::T1), interior(false), prev(nullptr),
+      next(nullptr) {}
+
+void CARReplacementPageCache::Clock::insertTail(CARReplacementPage *page) {
+  if (hand == nullptr) {
+    page->prev = page;
+    page->next = page;
+    hand = page;
+  } else {
+    page->prev = hand->prev;
+    page->next = hand;
+    hand->prev->next = page;
+    hand->prev = page;
+  }
+  ++size;
+  numUnpinned += !page->pinned;
+}
+
+void CARReplacementPageCache::Clock::remove(CARReplacementPage *page) {
+  if (page->next == page) {
+    hand = nullptr;
+  } else {
+    if (hand == page) {
+      hand = page->next;
+    }
+    page->prev->next = page->next;
+    page->next->prev = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  --size;
+  numUnpinned -= !page->pinned;
+}
+
+void CARReplacementPageCache::PageList::pushBack(CARReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+  ++size;
+}
+
+void CARReplacementPageCache::PageList::remove(CARReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  --size;
+}
+
+CARReplacementPageCache::CARReplacementPageCache(int pageSize, int extraSize)
+    : PageCache(pageSize, extraSize), p_(0) {}
+
+CARReplacementPageCache::~CARReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void CARReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+  p_ = std::min(p_, std::max(maxNumPages_, 0));
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  CARReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    pages_.erase(page->pageId);
+    delete page;
+  }
+
+  // The ghost lists are bounded relative to the new cache size.
+  trimGhosts();
+}
+
+int CARReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
+Page *CARReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, set its reference bit, and
+  // return the pointer. The page stays where it is on its clock. An interior
+  // page returns to the tail of its clock.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    CARReplacementPage *page = pagesIterator->second;
+    if (page->interior) {
+      (page->list == List::T1 ? interiorT1_ : interiorT2_).remove(page);
+      page->interior = false;
+      page->pinned = true;
+      (page->list == List::T1 ? t1_ : t2_).insertTail(page);
+    } else if (!page->pinned) {
+      --(page->list == List::T1 ? t1_ : t2_).numUnpinned;
+      page->pinned = true;
+    }
+    page->referenced = true;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Allocate a new page if the number of pages in the cache is less than the
+  // maximum. Otherwise, replace an existing unpinned page. If all pages are
+  // pinned, return a null pointer.
+  CARReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new CARReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    pages_.erase(page->pageId);
+    page->pageId = pageId;
+    page->pinned = true;
+    page->referenced = false;
+  }
+  pages_.emplace(pageId, page);
+
+  // A page found in B1 grows the target size of T1 and a page found in B2
+  // shrinks it. Either way, the page has been seen before and enters T2.
+  // Otherwise, it enters T1.
+  auto ghostsIterator = ghosts_.find(pageId);
+  if (ghostsIterator == ghosts_.end()) {
+    page->list = List::T1;
+    t1_.insertTail(page);
+  } else {
+    if (ghostsIterator->second.list == List::B1) {
+      int delta = std::max((int)b2_.size() / (int)b1_.size(), 1);
+      p_ = std::min(p_ + delta, maxNumPages_);
+    } else {
+      int delta = std::max((int)b1_.size() / (int)b2_.size(), 1);
+      p_ = std::max(p_ - delta, 0);
+    }
+    eraseGhost(pageId);
+    page->list = List::T2;
+    t2_.insertTail(page);
+  }
+  trimGhosts();
+  return page;
+}
+
+void CARReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (CARReplacementPage *)pageBase;
+
+  // If discard is true, discard the page. If the number of pages in the cache
+  // is greater than the maximum, replace the page, remembering it in a ghost
+  // list.
+  if (discard) {
+    discardPage(page);
+    return;
+  }
+  if (getNumPages() > maxNumPages_) {
+    unsigned pageId = page->pageId;
+    List list = page->list == List::T1 ? List::B1 : List::B2;
+    discardPage(page);
+    pushGhost(pageId, list);
+    trimGhosts();
+    return;
+  }
+
+  // Otherwise, unpin the page. SQLite has written the page by now, so classify
+  // it by its page-type byte. A protected interior page leaves its clock.
+  if (page->pinned) {
+    Clock &clock = page->list == List::T1 ? t1_ : t2_;
+    if (isProtectedPage(page, page->pageId)) {
+      clock.remove(page);
+      page->pinned = false;
+      page->interior = true;
+      (page->list == List::T1 ? interiorT1_ : interiorT2_).pushBack(page);
+    } else {
+      ++clock.numUnpinned;
+      page->pinned = false;
+    }
+  }
+}
+
+void CARReplacementPageCache::changePageId(Page *pageBase, unsigned newPageId) {
+  auto *page = (CARReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  eraseGhost(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    removeFromClock(pagesIterator->second);
+    delete pagesIterator->second;
+    pagesIterator->second = page;
+  }
+}
+
+void CARReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    CARReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromClock(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so forget their ghosts as well.
+  for (auto ghostsIterator = ghosts_.begin();
+       ghostsIterator != ghosts_.end();) {
+    if (ghostsIterator->first >= pageIdLimit) {
+      auto &ghostList = ghostsIterator->second.list == List::B1 ? b1_ : b2_;
+      ghostList.erase(ghostsIterator->second.iterator);
+      ghostsIterator = ghosts_.erase(ghostsIterator);
+    } else {
+      ++ghostsIterator;
+    }
+  }
+}
+
+CARReplacementPageCache::CARReplacementPage *
+CARReplacementPageCache::replacePage() {
+  if (t1_.numUnpinned == 0 && t2_.numUnpinned == 0) {
+    // Only protected interior pages are unpinned, if any. Replace one from the
+    // list chosen by `p`, or from the other list if that one is empty.
+    bool useT1 = getSize(List::T1) >= std::max(1, p_);
+    if ((useT1 ? interiorT1_ : interiorT2_).head == nullptr) {
+      useT1 = !useT1;
+    }
+    PageList &interior = useT1 ? interiorT1_ : interiorT2_;
+    CARReplacementPage *page = interior.head;
+    if (page == nullptr) {
+      return nullptr;
+    }
+    interior.remove(page);
+    page->interior = false;
+    pushGhost(page->pageId, useT1 ? List::B1 : List::B2);
+    return page;
+  }
+
+  while (true) {
+    bool useT1 = getSize(List::T1) >= std::max(1, p_);
+    if (useT1 ? t1_.numUnpinned == 0 : t2_.numUnpinned == 0) {
+      useT1 = !useT1;
+    }
+
+    if (useT1) {
+      CARReplacementPage *page = t1_.hand;
+      if (page->pinned) {
+        t1_.hand = page->next;
+      } else if (page->referenced) {
+        // The page was hit while in T1, so it moves to T2.
+        t1_.remove(page);
+        page->referenced = false;
+        page->list = List::T2;
+        t2_.insertTail(page);
+      } else {
+        t1_.remove(page);
+        pushGhost(page->pageId, List::B1);
+        return page;
+      }
+    } else {
+      CARReplacementPage *page = t2_.hand;
+      if (page->pinned) {
+        t2_.hand = page->next;
+      } else if (page->referenced) {
+        page->referenced = false;
+        t2_.hand = page->next;
+      } else {
+        t2_.remove(page);
+        pushGhost(page->pageId, List::B2);
+        return page;
+      }
+    }
+  }
+}
+
+void CARReplacementPageCache::pushGhost(unsigned pageId, List list) {
+  auto &ghostList = list == List::B1 ? b1_ : b2_;
+  ghostList.push_back(pageId);
+  ghosts_[pageId] = {list, std::prev(ghostList.end())};
+}
+
+void CARReplacementPageCache::eraseGhost(unsigned pageId) {
+  auto ghostsIterator = ghosts_.find(pageId);
+  if (ghostsIterator == ghosts_.end()) {
+    return;
+  }
+
+  auto &ghostList = ghostsIterator->second.list == List::B1 ? b1_ : b2_;
+  ghostList.erase(ghostsIterator->second.iterator);
+  ghosts_.erase(ghostsIterator);
+}
+
+void CARReplacementPageCache::trimGhosts() {
+  int maxNumPages = std::max(maxNumPages_, 0);
+  int t1Size = getSize(List::T1);
+  int t2Size = getSize(List::T2);
+  while (!b1_.empty() && t1Size + (int)b1_.size() > maxNumPages) {
+    ghosts_.erase(b1_.front());
+    b1_.pop_front();
+  }
+  while (!b2_.empty() &&
+         t1Size + t2Size + (int)b1_.size() + (int)b2_.size() >
+             2 * maxNumPages) {
+    ghosts_.erase(b2_.front());
+    b2_.pop_front();
+  }
+  while (!b1_.empty() &&
+         t1Size + t2Size + (int)b1_.size() + (int)b2_.size() >
+             2 * maxNumPages) {
+    ghosts_.erase(b1_.front());
+    b1_.pop_front();
+  }
+}
+
+void CARReplacementPageCache::removeFromClock(CARReplacementPage *page) {
+  if (page->interior) {
+    (page->list == List::T1 ? interiorT1_ : interiorT2_).remove(page);
+    page->interior = false;
+  } else {
+    (page->list == List::T1 ? t1_ : t2_).remove(page);
+  }
+}
+
+int CARReplacementPageCache::getSize(List list) const {
+  return list == List::T1 ? t1_.size + interiorT1_.size
+                          : t2_.size + interiorT2_.size;
+}
+
+void CARReplacementPageCache::discardPage(CARReplacementPage *page) {
+  removeFromClock(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
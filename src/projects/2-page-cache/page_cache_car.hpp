@@ -0,0 +1,156 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_CAR_HPP
+#define CS564_PROJECT_PAGE_CACHE_CAR_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+
+/**
+ * Clock with Adaptive Replacement as described by Bansal and Modha. Resident
+ * pages live on two clocks, T1 and T2, and a hit only sets a reference bit.
+ * The ghost lists B1 and B2 and the target size `p` of T1 adapt as in ARC.
+ */
+class CARReplacementPageCache : public PageCache {
+public:
+  CARReplacementPageCache(int pageSize, int extraSize);
+
+  ~CARReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  enum class List { T1, T2, B1, B2 };
+
+  struct CARReplacementPage : public Page {
+    CARReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+    bool referenced;
+
+    /** T1 or T2. */
+    List list;
+
+    /**
+     * Whether the page is an unpinned protected interior page. Such pages are
+     * taken off their clock and kept in a separate list until fetched again.
+     */
+    bool interior;
+
+    /** Neighbors on the clock of `list`, or in its list of interior pages. */
+    CARReplacementPage *prev;
+    CARReplacementPage *next;
+  };
+
+  struct Clock {
+    /** Page under the hand. The page just behind it is the tail. */
+    CARReplacementPage *hand = nullptr;
+
+    /** Number of pages on the clock, pinned or not. */
+    int size = 0;
+
+    /** Number of unpinned pages on the clock. */
+    int numUnpinned = 0;
+
+    void insertTail(CARReplacementPage *page);
+    void remove(CARReplacementPage *page);
+  };
+
+  struct PageList {
+    CARReplacementPage *head = nullptr;
+    CARReplacementPage *tail = nullptr;
+    int size = 0;
+
+    void pushBack(CARReplacementPage *page);
+    void remove(CARReplacementPage *page);
+  };
+
+  struct Ghost {
+    List list;
+    std::list<unsigned>::iterator iterator;
+  };
+
+  /**
+   * Run the hands until an unpinned, unreferenced page is found, following
+   * CAR's replace routine, and remember its page ID in B1 or B2. Referenced
+   * pages under the T1 hand move to T2. Pinned pages are passed over without
+   * clearing their reference bits. If the clock chosen by `p` has no unpinned
+   * page, the other clock is used. Protected interior pages are off the clocks
+   * and are only chosen, least recently unpinned first, if no other page is
+   * unpinned.
+   * @return Pointer to a page, removed from its clock. Null if all pages are
+   * pinned.
+   */
+  CARReplacementPage *replacePage();
+
+  /**
+   * Add a page ID at the most recent end of a ghost list.
+   * @param pageId Page ID.
+   * @param list B1 or B2.
+   */
+  void pushGhost(unsigned pageId, List list);
+
+  /**
+   * Remove a page ID from the ghost lists, if present.
+   * @param pageId Page ID.
+   */
+  void eraseGhost(unsigned pageId);
+
+  /**
+   * Drop the oldest ghost page IDs until |T1| + |B1| <= c and
+   * |T1| + |T2| + |B1| + |B2| <= 2c.
+   */
+  void trimGhosts();
+
+  /**
+   * Remove a page from its clock, or from its list of interior pages.
+   * @param page Pointer to a page.
+   */
+  void removeFromClock(CARReplacementPage *page);
+
+  /**
+   * Get the number of pages in T1 or T2, including interior pages.
+   * @param list T1 or T2.
+   * @return Number of pages.
+   */
+  [[nodiscard]] int getSize(List list) const;
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(CARReplacementPage *page);
+
+  std::unordered_map<unsigned, CARReplacementPage *> pages_;
+
+  Clock t1_;
+  Clock t2_;
+
+  /**
+   * Unpinned protected interior pages of T1 and T2, least recently unpinned
+   * first. Empty unless interior pages are protected.
+   */
+  PageList interiorT1_;
+  PageList interiorT2_;
+
+  /** Ghost page IDs, least recently replaced first. */
+  std::list<unsigned> b1_;
+  std::list<unsigned> b2_;
+  std::unordered_map<unsigned, Ghost> ghosts_;
+
+  /** Target size of T1. */
+  int p_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_CAR_HPP
@@ -0,0 +1,5 @@
+#include "page_cache_clock.hpp"
+
+ClockReplacementPageCache::ClockReplacementPageCache(int pageSize,
+                                                     int extraSize)
+    : GClockReplacementPageCache(pageSize, extraSize, 1, 1, 1) {}
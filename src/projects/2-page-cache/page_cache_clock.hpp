@@ -0,0 +1,16 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_CLOCK_HPP
+#define CS564_PROJECT_PAGE_CACHE_CLOCK_HPP
+
+#include "page_cache_gclock.hpp"
+
+/**
+ * CLOCK is GCLOCK with a one-bit counter. A page's reference bit is set when
+ * it is allocated or hit and cleared as the hand passes, so an unpinned page is
+ * replaced once the hand passes it twice without a hit in between.
+ */
+class ClockReplacementPageCache : public GClockReplacementPageCache {
+public:
+  ClockReplacementPageCache(int pageSize, int extraSize);
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_CLOCK_HPP
@@ -0,0 +1,426 @@
+#include "page_cache_clock_pro.hpp"
+
+#include <algorithm>
+
+ClockProReplacementPageCache::ClockProReplacementPage::ClockProReplacementPage(
+    int argPageSize, int argExtraSize)
+    : Page(argPageSize, argExtraSize), entry(nullptr) {}
+
+ClockProReplacementPageCache::ClockProReplacementPageCache(int pageSize,
+                                                           int extraSize)
+    : PageCache(pageSize, extraSize), handHot_(nullptr), handCold_(nullptr),
+      handTest_(nullptr), interiorHead_(nullptr), interiorTail_(nullptr),
+      numHot_(0), numCold_(0), numTest_(0), numUnpinned_(0), numInterior_(0),
+      coldTarget_(1) {}
+
+ClockProReplacementPageCache::~ClockProReplacementPageCache() {
+  for (auto &[pageId, entry] : entries_) {
+    delete entry->page;
+    delete entry;
+  }
+  for (ClockProReplacementPage *page : freePages_) {
+    delete page;
+  }
+}
+
+void ClockProReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+  coldTarget_ = std::min(coldTarget_, std::max(maxNumPages_, 1));
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  while (getNumPages() > maxNumPages_ &&
+         (numUnpinned_ > 0 || interiorHead_ != nullptr)) {
+    delete obtainPage();
+  }
+
+  // Keep at most `maxNumPages_` test entries.
+  while (numTest_ > maxNumPages_) {
+    runHandTest();
+  }
+
+  for (ClockProReplacementPage *page : freePages_) {
+    delete page;
+  }
+  freePages_.clear();
+}
+
+int ClockProReplacementPageCache::getNumPages() const {
+  return numHot_ + numCold_ + numInterior_;
+}
+
+Page *ClockProReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, mark it referenced, and return
+  // the pointer. An interior page goes back on the clock at the head.
+  auto entriesIterator = entries_.find(pageId);
+  if (entriesIterator != entries_.end() &&
+      entriesIterator->second->status != Status::Test) {
+    ++numHits_;
+    Entry *entry = entriesIterator->second;
+    if (entry->interior) {
+      removeInterior(entry);
+      ++(entry->status == Status::Hot ? numHot_ : numCold_);
+      insertEntry(entry);
+    } else {
+      numUnpinned_ -= !entry->pinned;
+    }
+    entry->pinned = true;
+    entry->referenced = true;
+    return entry->page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. Allocate a new page, or replace an existing
+  // unpinned page if the cache is full. If all pages are pinned, return a null
+  // pointer.
+  ClockProReplacementPage *page = obtainPage();
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  // Running the hands may have ended the test period of the page, so look it
+  // up again. A page fetched during its test period has a small reuse
+  // distance: it becomes hot, and cold pages get a larger share of the cache.
+  Entry *entry;
+  entriesIterator = entries_.find(pageId);
+  if (entriesIterator != entries_.end()) {
+    entry = entriesIterator->second;
+    coldTarget_ = std::min(coldTarget_ + 1, std::max(maxNumPages_, 1));
+    discardEntry(entry);
+    entry = new Entry{pageId, Status::Hot, true, false, false, false, page,
+                      nullptr, nullptr};
+    ++numHot_;
+  } else {
+    entry = new Entry{pageId, Status::Cold, true, false, true, false, page,
+                      nullptr, nullptr};
+    ++numCold_;
+  }
+  page->entry = entry;
+  entries_.emplace(pageId, entry);
+  insertEntry(entry);
+
+  while (numHot_ > std::max(maxNumPages_ - coldTarget_, 0)) {
+    runHandHot();
+  }
+  return page;
+}
+
+void ClockProReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (ClockProReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page. Otherwise, unpin the page. SQLite has written
+  // the page by now, so classify it by its page-type byte. A protected interior
+  // page leaves the clock.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardEntry(page->entry);
+  } else if (page->entry->pinned) {
+    page->entry->pinned = false;
+    if (isProtectedPage(page, page->entry->pageId)) {
+      pushInterior(page->entry);
+    } else {
+      ++numUnpinned_;
+    }
+  }
+}
+
+void ClockProReplacementPageCache::changePageId(Page *pageBase,
+                                                unsigned newPageId) {
+  auto *page = (ClockProReplacementPage *)pageBase;
+
+  // If a page or test entry with page ID `newPageId` is already on the clock,
+  // discard it.
+  auto entriesIterator = entries_.find(newPageId);
+  if (entriesIterator != entries_.end()) {
+    discardEntry(entriesIterator->second);
+  }
+
+  // Change the page ID.
+  entries_.erase(page->entry->pageId);
+  page->entry->pageId = newPageId;
+  entries_.emplace(newPageId, page->entry);
+}
+
+void ClockProReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages and test entries with page ID greater than or equal to
+  // `pageIdLimit`.
+  std::vector<Entry *> discarded;
+  for (auto &[pageId, entry] : entries_) {
+    if (pageId >= pageIdLimit) {
+      discarded.push_back(entry);
+    }
+  }
+  for (Entry *entry : discarded) {
+    discardEntry(entry);
+  }
+}
+
+ClockProReplacementPageCache::ClockProReplacementPage *
+ClockProReplacementPageCache::obtainPage() {
+  if (freePages_.empty()) {
+    if (getNumPages() < maxNumPages_) {
+      return new ClockProReplacementPage(pageSize_, extraSize_);
+    }
+    // Protected interior pages are only replaced if no other page is unpinned.
+    // Their entries leave the cache without becoming test entries.
+    if (numUnpinned_ == 0) {
+      Entry *entry = interiorHead_;
+      if (entry == nullptr) {
+        return nullptr;
+      }
+      ClockProReplacementPage *page = entry->page;
+      page->entry = nullptr;
+      entry->page = nullptr;
+      discardEntry(entry);
+      return page;
+    }
+
+    // Run the cold hand until it replaces a page. If every unpinned page is
+    // hot, the cold hand finds nothing, so after a full revolution the hot hand
+    // is run as well to demote them. The cold hand may have emptied the clock
+    // by replacing a page, so the hot hand only runs if it did not.
+    for (int steps = 0; freePages_.empty(); ++steps) {
+      runHandCold();
+      if (freePages_.empty() && steps > numHot_ + numCold_ + numTest_) {
+        runHandHot();
+      }
+    }
+  }
+
+  ClockProReplacementPage *page = freePages_.back();
+  freePages_.pop_back();
+  return page;
+}
+
+void ClockProReplacementPageCache::runHandCold() {
+  Entry *entry = handCold_;
+  handCold_ = entry->next;
+  if (entry->status == Status::Cold && !entry->pinned) {
+    if (entry->referenced) {
+      // A reference during the test period means a small reuse distance: the
+      // page becomes hot, and cold pages get a larger share of the cache. A
+      // later reference only starts a new test period.
+      entry->referenced = false;
+      if (entry->testPeriod) {
+        entry->status = Status::Hot;
+        entry->testPeriod = false;
+        --numCold_;
+        ++numHot_;
+        coldTarget_ = std::min(coldTarget_ + 1, std::max(maxNumPages_, 1));
+      } else {
+        entry->testPeriod = true;
+      }
+      moveEntryToHead(entry);
+    } else if (!entry->testPeriod) {
+      // The page was not referenced again and its test period is over, so it
+      // leaves the clock.
+      entry->page->entry = nullptr;
+      freePages_.push_back(entry->page);
+      entry->page = nullptr;
+      --numUnpinned_;
+      discardEntry(entry);
+    } else {
+      entry->status = Status::Test;
+      entry->page->entry = nullptr;
+      freePages_.push_back(entry->page);
+      entry->page = nullptr;
+      --numCold_;
+      --numUnpinned_;
+      ++numTest_;
+
+      // The new test entry starts its test period, so the test hand must not
+      // end it before the hands come around again.
+      if (handTest_ == entry) {
+        handTest_ = entry->next;
+      }
+    }
+  }
+
+  // Keep at most `maxNumPages_` test entries, then keep the number of hot pages
+  // within its target. Neither hand runs the cold hand.
+  while (numTest_ > maxNumPages_) {
+    runHandTest();
+  }
+  while (numHot_ > std::max(maxNumPages_ - coldTarget_, 0)) {
+    runHandHot();
+  }
+}
+
+void ClockProReplacementPageCache::runHandHot() {
+  // The hot hand pushes the test hand ahead of it, and ends the test period of
+  // any test entry it passes.
+  Entry *entry = handHot_;
+  handHot_ = entry->next;
+  if (handTest_ == entry) {
+    handTest_ = entry->next;
+  }
+
+  // Pinned hot pages are demoted too. The cold hand skips them until they are
+  // unpinned, and demoting them keeps the hot hand from spinning.
+  switch (entry->status) {
+  case Status::Hot:
+    if (entry->referenced) {
+      entry->referenced = false;
+    } else {
+      entry->status = Status::Cold;
+      --numHot_;
+      ++numCold_;
+    }
+    break;
+  case Status::Cold:
+    if (entry->testPeriod && !entry->referenced) {
+      endTestPeriod(entry);
+    }
+    break;
+  case Status::Test:
+    endTestPeriod(entry);
+    break;
+  }
+}
+
+void ClockProReplacementPageCache::runHandTest() {
+  // Move the test hand to the next test entry and end its test period, ending
+  // the test periods of unreferenced cold pages on the way. The caller
+  // guarantees that there is a test entry.
+  Entry *entry = handTest_;
+  while (entry->status != Status::Test) {
+    if (entry->status == Status::Cold && entry->testPeriod &&
+        !entry->referenced) {
+      endTestPeriod(entry);
+    }
+    entry = entry->next;
+  }
+  handTest_ = entry->next;
+  endTestPeriod(entry);
+}
+
+void ClockProReplacementPageCache::insertEntry(Entry *entry) {
+  if (handHot_ == nullptr) {
+    entry->prev = entry;
+    entry->next = entry;
+    handHot_ = entry;
+    handCold_ = entry;
+    handTest_ = entry;
+    return;
+  }
+
+  entry->prev = handHot_->prev;
+  entry->next = handHot_;
+  handHot_->prev->next = entry;
+  handHot_->prev = entry;
+}
+
+void ClockProReplacementPageCache::moveEntryToHead(Entry *entry) {
+  if (entry->next == entry) {
+    return;
+  }
+  if (handHot_ == entry) {
+    handHot_ = entry->next;
+  }
+  if (handCold_ == entry) {
+    handCold_ = entry->next;
+  }
+  if (handTest_ == entry) {
+    handTest_ = entry->next;
+  }
+  entry->prev->next = entry->next;
+  entry->next->prev = entry->prev;
+  insertEntry(entry);
+}
+
+void ClockProReplacementPageCache::endTestPeriod(Entry *entry) {
+  coldTarget_ = std::max(coldTarget_ - 1, 1);
+  if (entry->status == Status::Test) {
+    discardEntry(entry);
+  } else {
+    entry->testPeriod = false;
+  }
+}
+
+void ClockProReplacementPageCache::unlinkEntry(Entry *entry) {
+  if (entry->next == entry) {
+    handHot_ = nullptr;
+    handCold_ = nullptr;
+    handTest_ = nullptr;
+  } else {
+    if (handHot_ == entry) {
+      handHot_ = entry->prev;
+    }
+    if (handCold_ == entry) {
+      handCold_ = entry->prev;
+    }
+    if (handTest_ == entry) {
+      handTest_ = entry->prev;
+    }
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+  }
+  entry->prev = nullptr;
+  entry->next = nullptr;
+}
+
+void ClockProReplacementPageCache::pushInterior(Entry *entry) {
+  unlinkEntry(entry);
+  --(entry->status == Status::Hot ? numHot_ : numCold_);
+  ++numInterior_;
+
+  entry->interior = true;
+  entry->prev = interiorTail_;
+  entry->next = nullptr;
+  if (interiorTail_ != nullptr) {
+    interiorTail_->next = entry;
+  } else {
+    interiorHead_ = entry;
+  }
+  interiorTail_ = entry;
+}
+
+void ClockProReplacementPageCache::removeInterior(Entry *entry) {
+  if (entry->prev != nullptr) {
+    entry->prev->next = entry->next;
+  } else {
+    interiorHead_ = entry->next;
+  }
+  if (entry->next != nullptr) {
+    entry->next->prev = entry->prev;
+  } else {
+    interiorTail_ = entry->prev;
+  }
+  entry->prev = nullptr;
+  entry->next = nullptr;
+  entry->interior = false;
+  --numInterior_;
+}
+
+void ClockProReplacementPageCache::discardEntry(Entry *entry) {
+  if (entry->interior) {
+    removeInterior(entry);
+  } else {
+    switch (entry->status) {
+    case Status::Hot:
+      --numHot_;
+      break;
+    case Status::Cold:
+      --numCold_;
+      break;
+    case Status::Test:
+      --numTest_;
+      break;
+    }
+    if (entry->page != nullptr && !entry->pinned) {
+      --numUnpinned_;
+    }
+    unlinkEntry(entry);
+  }
+
+  entries_.erase(entry->pageId);
+  delete entry->page;
+  delete entry;
+}
@@ -0,0 +1,183 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_CLOCK_PRO_HPP
+#define CS564_PROJECT_PAGE_CACHE_CLOCK_PRO_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * CLOCK-Pro page cache as described by Jiang, Chen, and Zhang. Resident pages
+ * are hot or cold. A cold page starts a test period when it is inserted, and
+ * if it is replaced during that period it stays on the clock as a non-resident
+ * test entry. A reference to a cold page during its test period promotes it to
+ * hot and grows the share of the cache given to cold pages. A test period that
+ * the hot or test hand ends without a reference shrinks that share.
+ */
+class ClockProReplacementPageCache : public PageCache {
+public:
+  ClockProReplacementPageCache(int pageSize, int extraSize);
+
+  ~ClockProReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct ClockProReplacementPage;
+
+  enum class Status { Hot, Cold, Test };
+
+  /** Entry on the clock. Test entries have no page. */
+  struct Entry {
+    unsigned pageId;
+    Status status;
+    bool pinned;
+    bool referenced;
+
+    /** Whether a cold page is in its test period. Set for test entries. */
+    bool testPeriod;
+
+    /**
+     * Whether the page is an unpinned protected interior page. Such pages are
+     * taken off the clock and kept in a separate list until fetched again.
+     */
+    bool interior;
+
+    ClockProReplacementPage *page;
+
+    /** Neighbors on the clock, or in the list of interior pages. */
+    Entry *prev;
+    Entry *next;
+  };
+
+  struct ClockProReplacementPage : public Page {
+    ClockProReplacementPage(int pageSize, int extraSize);
+
+    Entry *entry;
+  };
+
+  /**
+   * Get a page for a miss, either from `freePages_`, by allocating a new page,
+   * or by running the cold hand until it replaces a page. If only protected
+   * interior pages are unpinned, the least recently unpinned one is replaced
+   * instead.
+   * @return Pointer to a page. Null if all pages are pinned.
+   */
+  ClockProReplacementPage *obtainPage();
+
+  /**
+   * Step the cold hand over an unpinned cold page. If the page is referenced
+   * during its test period, it is promoted to hot. If it is referenced after
+   * its test period, it starts a new one. Either way it moves to the head of
+   * the clock. An unreferenced page is replaced: its page moves to
+   * `freePages_`, and its entry becomes a test entry if it is in its test
+   * period or leaves the clock otherwise. Afterwards the test hand and the hot
+   * hand run until the number of test entries and the number of hot pages are
+   * within their limits.
+   */
+  void runHandCold();
+
+  /**
+   * Step the hot hand. An unreferenced hot page is demoted to cold, the test
+   * period of an unreferenced cold page ends, and a test entry is removed and
+   * its test period ends. The test hand is pushed ahead of the hot hand.
+   */
+  void runHandHot();
+
+  /**
+   * Move the test hand to the next test entry, remove it and end its test
+   * period. The test periods of unreferenced cold pages that the hand passes
+   * end as well. There must be at least one test entry.
+   */
+  void runHandTest();
+
+  /**
+   * Insert an entry at the head of the clock, just behind the hot hand.
+   * @param entry Pointer to an entry.
+   */
+  void insertEntry(Entry *entry);
+
+  /**
+   * Move an entry to the head of the clock, just behind the hot hand. Hands
+   * that point at the entry move on to the next entry.
+   * @param entry Pointer to an entry.
+   */
+  void moveEntryToHead(Entry *entry);
+
+  /**
+   * End the test period of a cold page or test entry that was not referenced
+   * during it, and shrink the target number of cold pages.
+   * @param entry Pointer to an entry in its test period.
+   */
+  void endTestPeriod(Entry *entry);
+
+  /**
+   * Remove an entry from the clock. Hands that point at the entry move back to
+   * the previous entry.
+   * @param entry Pointer to an entry on the clock.
+   */
+  void unlinkEntry(Entry *entry);
+
+  /**
+   * Take an unpinned page off the clock and append it to the list of interior
+   * pages.
+   * @param entry Pointer to an entry on the clock.
+   */
+  void pushInterior(Entry *entry);
+
+  /**
+   * Remove a page from the list of interior pages. It is not put back on the
+   * clock.
+   * @param entry Pointer to an entry in the list.
+   */
+  void removeInterior(Entry *entry);
+
+  /**
+   * Remove an entry from the clock, or the list of interior pages, and the
+   * cache, freeing its page if it has one.
+   * @param entry Pointer to an entry.
+   */
+  void discardEntry(Entry *entry);
+
+  /** All entries on the clock, by page ID. */
+  std::unordered_map<unsigned, Entry *> entries_;
+
+  /** Replaced pages waiting to be reused. Not counted as cached. */
+  std::vector<ClockProReplacementPage *> freePages_;
+
+  Entry *handHot_;
+  Entry *handCold_;
+  Entry *handTest_;
+
+  /**
+   * Least and most recently unpinned protected interior pages, kept off the
+   * clock. Empty unless interior pages are protected.
+   */
+  Entry *interiorHead_;
+  Entry *interiorTail_;
+
+  /** Numbers of entries on the clock, by status. */
+  int numHot_;
+  int numCold_;
+  int numTest_;
+
+  /** Number of unpinned pages on the clock. */
+  int numUnpinned_;
+
+  int numInterior_;
+
+  /** Adaptive target number of resident cold pages. */
+  int coldTarget_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_CLOCK_PRO_HPP
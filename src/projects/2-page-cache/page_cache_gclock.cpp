@@ -0,0 +1,236 @@
+#include "page_cache_gclock.hpp"
+
+#include <algorithm>
+
+GClockReplacementPageCache::GClockReplacementPage::GClockReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId,
+    unsigned char argCount)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      count(argCount), interior(false), prev(nullptr), next(nullptr) {}
+
+GClockReplacementPageCache::GClockReplacementPageCache(
+    int pageSize, int extraSize, unsigned char initialWeight,
+    unsigned char hitWeight, unsigned char maxWeight)
+    : PageCache(pageSize, extraSize), hand_(nullptr), numUnpinned_(0),
+      interiorHead_(nullptr), interiorTail_(nullptr),
+      initialWeight_(std::min(initialWeight, maxWeight)),
+      hitWeight_(hitWeight), maxWeight_(maxWeight) {}
+
+GClockReplacementPageCache::~GClockReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void GClockReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Discard unpinned pages chosen by the hand until the number of pages in the
+  // cache is less than or equal to `maxNumPages_` or only pinned pages remain.
+  GClockReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = sweep()) != nullptr) {
+    discardPage(page);
+  }
+}
+
+int GClockReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *GClockReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, increment its counter, and
+  // return the pointer. The hit touches only the page itself, unless it is an
+  // interior page, which goes back into the circular list behind the hand.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    GClockReplacementPage *page = pagesIterator->second;
+    if (page->interior) {
+      removeInterior(page);
+      insertPage(page);
+    } else {
+      numUnpinned_ -= !page->pinned;
+    }
+    page->pinned = true;
+    page->count = maxWeight_ - page->count > hitWeight_
+                      ? page->count + hitWeight_
+                      : maxWeight_;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate and return a pointer to a new page.
+  if (getNumPages() < maxNumPages_) {
+    auto page = new GClockReplacementPage(pageSize_, extraSize_, pageId,
+                                          initialWeight_);
+    insertPage(page);
+    pages_.emplace(pageId, page);
+    return page;
+  }
+
+  // The number of pages in the cache is greater than or equal to the maximum.
+  // If all pages are pinned, return a null pointer.
+  GClockReplacementPage *page = sweep();
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  // Replace the page chosen by the hand. The hand has already moved past it,
+  // so the new page keeps its place just behind the hand.
+  pages_.erase(page->pageId);
+  page->pageId = pageId;
+  page->pinned = true;
+  page->count = initialWeight_;
+  pages_.emplace(pageId, page);
+  --numUnpinned_;
+  return page;
+}
+
+void GClockReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (GClockReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page. Otherwise, unpin the page. SQLite has written
+  // the page by now, so classify it by its page-type byte. A protected interior
+  // page leaves the circular list.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+  } else if (page->pinned) {
+    page->pinned = false;
+    if (isProtectedPage(page, page->pageId)) {
+      unlinkPage(page);
+      pushInterior(page);
+    } else {
+      ++numUnpinned_;
+    }
+  }
+}
+
+void GClockReplacementPageCache::changePageId(Page *pageBase,
+                                              unsigned newPageId) {
+  auto *page = (GClockReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  auto pagesIterator = pages_.find(newPageId);
+  if (pagesIterator != pages_.end()) {
+    discardPage(pagesIterator->second);
+  }
+  pages_.emplace(newPageId, page);
+}
+
+void GClockReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    GClockReplacementPage *page = pagesIterator->second;
+    ++pagesIterator;
+    if (page->pageId >= pageIdLimit) {
+      discardPage(page);
+    }
+  }
+}
+
+void GClockReplacementPageCache::insertPage(GClockReplacementPage *page) {
+  if (hand_ == nullptr) {
+    page->prev = page;
+    page->next = page;
+    hand_ = page;
+    return;
+  }
+  page->prev = hand_->prev;
+  page->next = hand_;
+  hand_->prev->next = page;
+  hand_->prev = page;
+}
+
+GClockReplacementPageCache::GClockReplacementPage *
+GClockReplacementPageCache::sweep() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (numUnpinned_ == 0) {
+    GClockReplacementPage *page = interiorHead_;
+    if (page != nullptr) {
+      removeInterior(page);
+      insertPage(page);
+      ++numUnpinned_;
+    }
+    return page;
+  }
+
+  // Every unpinned counter reaches zero within `maxWeight_` revolutions.
+  while (true) {
+    GClockReplacementPage *page = hand_;
+    hand_ = hand_->next;
+    if (page->pinned) {
+      continue;
+    }
+    if (page->count == 0) {
+      return page;
+    }
+    --page->count;
+  }
+}
+
+void GClockReplacementPageCache::unlinkPage(GClockReplacementPage *page) {
+  if (page->next == page) {
+    hand_ = nullptr;
+  } else {
+    page->prev->next = page->next;
+    page->next->prev = page->prev;
+    if (hand_ == page) {
+      hand_ = page->next;
+    }
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+void GClockReplacementPageCache::pushInterior(GClockReplacementPage *page) {
+  page->interior = true;
+  page->prev = interiorTail_;
+  page->next = nullptr;
+  if (interiorTail_ != nullptr) {
+    interiorTail_->next = page;
+  } else {
+    interiorHead_ = page;
+  }
+  interiorTail_ = page;
+}
+
+void GClockReplacementPageCache::removeInterior(GClockReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    interiorHead_ = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    interiorTail_ = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  page->interior = false;
+}
+
+void GClockReplacementPageCache::discardPage(GClockReplacementPage *page) {
+  if (page->interior) {
+    removeInterior(page);
+  } else {
+    numUnpinned_ -= !page->pinned;
+    unlinkPage(page);
+  }
+
+  pages_.erase(page->pageId);
+  delete page;
+}
@@ -0,0 +1,128 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_GCLOCK_HPP
+#define CS564_PROJECT_PAGE_CACHE_GCLOCK_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+
+class GClockReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct a GClockReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param initialWeight Counter value of a newly allocated page.
+   * @param hitWeight Amount added to the counter on a hit.
+   * @param maxWeight Value at which the counter saturates.
+   */
+  GClockReplacementPageCache(int pageSize, int extraSize,
+                             unsigned char initialWeight = 1,
+                             unsigned char hitWeight = 1,
+                             unsigned char maxWeight = 15);
+
+  ~GClockReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct GClockReplacementPage : public Page {
+    GClockReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                          unsigned char count);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Incremented on a hit and decremented as the hand passes. */
+    unsigned char count;
+
+    /**
+     * Whether the page is an unpinned protected interior page. Such pages are
+     * taken out of the circular list and kept in a separate list until fetched
+     * again.
+     */
+    bool interior;
+
+    /**
+     * Neighbors in the circular list of pages swept by the hand, or in the list
+     * of interior pages.
+     */
+    GClockReplacementPage *prev;
+    GClockReplacementPage *next;
+  };
+
+  /**
+   * Insert a page into the circular list just behind the hand, so that the
+   * hand examines it after every other page.
+   * @param page Pointer to a page.
+   */
+  void insertPage(GClockReplacementPage *page);
+
+  /**
+   * Advance the hand until it reaches an unpinned page whose counter is zero,
+   * decrementing counters along the way. If only protected interior pages are
+   * unpinned, the least recently unpinned one is chosen instead and put back
+   * just behind the hand.
+   * @return Pointer to the page to replace. Null if all pages are pinned.
+   */
+  GClockReplacementPage *sweep();
+
+  /**
+   * Unlink a page from the circular list. If the hand points to the page, it
+   * moves on to the next page.
+   * @param page Pointer to a page in the circular list.
+   */
+  void unlinkPage(GClockReplacementPage *page);
+
+  /**
+   * Append an unpinned page to the list of interior pages.
+   * @param page Pointer to a page not in either list.
+   */
+  void pushInterior(GClockReplacementPage *page);
+
+  /**
+   * Remove an unpinned page from the list of interior pages.
+   * @param page Pointer to a page in the list.
+   */
+  void removeInterior(GClockReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it. If the hand points to the page,
+   * it moves on to the next page.
+   * @param page Pointer to a page.
+   */
+  void discardPage(GClockReplacementPage *page);
+
+  std::unordered_map<unsigned, GClockReplacementPage *> pages_;
+
+  /** Next page the hand will examine. Null if the cache is empty. */
+  GClockReplacementPage *hand_;
+
+  /**
+   * Number of unpinned pages in the circular list, so that a full cache fails
+   * fast.
+   */
+  int numUnpinned_;
+
+  /**
+   * Least and most recently unpinned protected interior pages, kept out of the
+   * circular list. Empty unless interior pages are protected.
+   */
+  GClockReplacementPage *interiorHead_;
+  GClockReplacementPage *interiorTail_;
+
+  unsigned char initialWeight_;
+  unsigned char hitWeight_;
+  unsigned char maxWeight_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_GCLOCK_HPP
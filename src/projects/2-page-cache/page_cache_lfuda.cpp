@@ -0,0 +1,257 @@
+#include "page_cache_lfuda.hpp"
+
+LFUDAReplacementPageCache::LFUDAReplacementPage::LFUDAReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      bucket(nullptr), interior(false), prev(nullptr), next(nullptr) {}
+
+LFUDAReplacementPageCache::Bucket::Bucket(unsigned long long argKey)
+    : key(argKey), numPages(0), head(nullptr), tail(nullptr), prev(nullptr),
+      next(nullptr) {}
+
+LFUDAReplacementPageCache::LFUDAReplacementPageCache(int pageSize,
+                                                     int extraSize)
+    : PageCache(pageSize, extraSize), head_(new Bucket(1)),
+      interiorHead_(nullptr), interiorTail_(nullptr), ageBucket_(head_) {
+  // The cache age starts at zero, so new pages enter with key 1.
+  acquireBucket(ageBucket_);
+}
+
+LFUDAReplacementPageCache::~LFUDAReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+  while (head_ != nullptr) {
+    Bucket *bucket = head_;
+    head_ = head_->next;
+    delete bucket;
+  }
+}
+
+void LFUDAReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  LFUDAReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+}
+
+int LFUDAReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *LFUDAReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, move it to the next bucket to
+  // increment its key, and return the pointer.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    LFUDAReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      removeUnpinned(page);
+      page->pinned = true;
+    }
+    Bucket *bucket = getNextBucket(page->bucket);
+    acquireBucket(bucket);
+    releaseBucket(page->bucket);
+    page->bucket = bucket;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  LFUDAReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new LFUDAReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+  }
+  page->bucket = ageBucket_;
+  acquireBucket(page->bucket);
+  pages_.emplace(pageId, page);
+  return page;
+}
+
+void LFUDAReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LFUDAReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page.
+  // SQLite has written the page by now, so classify it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+    page->interior = isProtectedPage(page, page->pageId);
+    pushUnpinned(page);
+  }
+}
+
+void LFUDAReplacementPageCache::changePageId(Page *pageBase,
+                                             unsigned newPageId) {
+  auto *page = (LFUDAReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    LFUDAReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    if (!oldPage->pinned) {
+      removeUnpinned(oldPage);
+    }
+    releaseBucket(oldPage->bucket);
+    delete oldPage;
+  }
+}
+
+void LFUDAReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    LFUDAReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (!page->pinned) {
+        removeUnpinned(page);
+      }
+      releaseBucket(page->bucket);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+LFUDAReplacementPageCache::LFUDAReplacementPage *
+LFUDAReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  LFUDAReplacementPage *page = nullptr;
+  for (Bucket *bucket = head_; page == nullptr && bucket != nullptr;
+       bucket = bucket->next) {
+    page = bucket->head;
+  }
+  if (page == nullptr) {
+    page = interiorHead_;
+  }
+  if (page == nullptr) {
+    return nullptr;
+  }
+  removeUnpinned(page);
+  pages_.erase(page->pageId);
+
+  // The cache age becomes the key of the page, so new pages now enter the
+  // bucket after it.
+  Bucket *bucket = getNextBucket(page->bucket);
+  acquireBucket(bucket);
+  releaseBucket(ageBucket_);
+  ageBucket_ = bucket;
+  releaseBucket(page->bucket);
+  page->bucket = nullptr;
+  return page;
+}
+
+LFUDAReplacementPageCache::Bucket *
+LFUDAReplacementPageCache::getNextBucket(Bucket *bucket) {
+  if (bucket->next != nullptr && bucket->next->key == bucket->key + 1) {
+    return bucket->next;
+  }
+
+  // Keys only grow one at a time from an existing bucket, so the new bucket
+  // belongs right after `bucket`.
+  auto *nextBucket = new Bucket(bucket->key + 1);
+  nextBucket->prev = bucket;
+  nextBucket->next = bucket->next;
+  if (bucket->next != nullptr) {
+    bucket->next->prev = nextBucket;
+  }
+  bucket->next = nextBucket;
+  return nextBucket;
+}
+
+void LFUDAReplacementPageCache::acquireBucket(Bucket *bucket) {
+  ++bucket->numPages;
+}
+
+void LFUDAReplacementPageCache::releaseBucket(Bucket *bucket) {
+  if (--bucket->numPages > 0) {
+    return;
+  }
+  if (bucket->prev != nullptr) {
+    bucket->prev->next = bucket->next;
+  } else {
+    head_ = bucket->next;
+  }
+  if (bucket->next != nullptr) {
+    bucket->next->prev = bucket->prev;
+  }
+  delete bucket;
+}
+
+void LFUDAReplacementPageCache::pushUnpinned(LFUDAReplacementPage *page) {
+  LFUDAReplacementPage *&head =
+      page->interior ? interiorHead_ : page->bucket->head;
+  LFUDAReplacementPage *&tail =
+      page->interior ? interiorTail_ : page->bucket->tail;
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void LFUDAReplacementPageCache::removeUnpinned(LFUDAReplacementPage *page) {
+  LFUDAReplacementPage *&head =
+      page->interior ? interiorHead_ : page->bucket->head;
+  LFUDAReplacementPage *&tail =
+      page->interior ? interiorTail_ : page->bucket->tail;
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+void LFUDAReplacementPageCache::discardPage(LFUDAReplacementPage *page) {
+  if (!page->pinned) {
+    removeUnpinned(page);
+  }
+  releaseBucket(page->bucket);
+  pages_.erase(page->pageId);
+  delete page;
+}
@@ -0,0 +1,150 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_LFUDA_HPP
+#define CS564_PROJECT_PAGE_CACHE_LFUDA_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+
+/**
+ * LFU page cache with dynamic aging (LFUDA). Each page has a key that starts
+ * at the cache age plus one and is incremented on every hit. The cache age is
+ * the key of the most recently replaced page, so pages that built up large
+ * keys long ago are eventually overtaken by new pages. Pages are grouped into
+ * buckets of equal key, kept in a linked list in increasing key order. A hit
+ * moves a page to the next bucket and the victim is the first unpinned page
+ * of the first bucket, so both are O(1).
+ */
+class LFUDAReplacementPageCache : public PageCache {
+public:
+  LFUDAReplacementPageCache(int pageSize, int extraSize);
+
+  ~LFUDAReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct LFUDAReplacementPage;
+
+  struct Bucket {
+    Bucket(unsigned long long key);
+
+    unsigned long long key;
+
+    /**
+     * Number of pages with this key, pinned or not. `ageBucket_` counts as a
+     * page too. The bucket is erased when this drops to zero.
+     */
+    int numPages;
+
+    /** Unpinned pages with this key, in the order they were unpinned. */
+    LFUDAReplacementPage *head;
+    LFUDAReplacementPage *tail;
+
+    /** Neighbors in the list of buckets. */
+    Bucket *prev;
+    Bucket *next;
+  };
+
+  struct LFUDAReplacementPage : public Page {
+    LFUDAReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Bucket of the page. The key of the page is the key of the bucket. */
+    Bucket *bucket;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Protected pages keep their bucket but are listed in
+     * `interiorHead_` instead of the bucket.
+     */
+    bool interior;
+
+    /** Neighbors in the bucket or the interior list. Unpinned pages only. */
+    LFUDAReplacementPage *prev;
+    LFUDAReplacementPage *next;
+  };
+
+  /**
+   * Choose a page to replace: the first unpinned page of the lowest bucket.
+   * Buckets that only hold pinned or interior pages are skipped, so this passes
+   * over at most one bucket per such page. If only protected interior pages
+   * are unpinned, the least recently unpinned one is chosen. The cache age
+   * becomes the key of the victim.
+   * @return Pointer to a page, removed from its bucket and `pages_`. Null if
+   * all pages are pinned.
+   */
+  LFUDAReplacementPage *replacePage();
+
+  /**
+   * Get the bucket with a key one greater than that of a given bucket,
+   * creating it right after the given bucket if necessary.
+   * @param bucket Pointer to a bucket.
+   * @return Pointer to the next bucket.
+   */
+  Bucket *getNextBucket(Bucket *bucket);
+
+  /**
+   * Add a page, or `ageBucket_`, to the pages counted by a bucket.
+   * @param bucket Pointer to a bucket.
+   */
+  void acquireBucket(Bucket *bucket);
+
+  /**
+   * Remove a page, or `ageBucket_`, from the pages counted by a bucket,
+   * erasing the bucket if no pages remain.
+   * @param bucket Pointer to a bucket.
+   */
+  void releaseBucket(Bucket *bucket);
+
+  /**
+   * Append a page to the unpinned pages of its bucket, or to the interior list
+   * if it is an interior page.
+   * @param page Pointer to an unpinned page.
+   */
+  void pushUnpinned(LFUDAReplacementPage *page);
+
+  /**
+   * Remove a page from the unpinned pages of its bucket, or from the interior
+   * list.
+   * @param page Pointer to an unpinned page.
+   */
+  void removeUnpinned(LFUDAReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(LFUDAReplacementPage *page);
+
+  std::unordered_map<unsigned, LFUDAReplacementPage *> pages_;
+
+  /** First bucket in increasing key order. */
+  Bucket *head_;
+
+  /**
+   * Least and most recently unpinned protected interior pages, across all
+   * buckets. Empty unless interior pages are protected.
+   */
+  LFUDAReplacementPage *interiorHead_;
+  LFUDAReplacementPage *interiorTail_;
+
+  /**
+   * Bucket where new pages enter. Its key is the cache age plus one, where the
+   * cache age is the key of the most recently replaced page.
+   */
+  Bucket *ageBucket_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_LFUDA_HPP
@@ -0,0 +1,338 @@
+#include "page_cache_lirs.hpp"
+
+#include <algorithm>
+#include <vector>
+
+LIRSReplacementPageCache::LIRSReplacementPage::LIRSReplacementPage(
+    int argPageSize, int argExtraSize)
+    : Page(argPageSize, argExtraSize), entry(nullptr) {}
+
+LIRSReplacementPageCache::LIRSReplacementPageCache(int pageSize, int extraSize,
+                                                   double hirFraction,
+                                                   double nonResidentRatio)
+    : PageCache(pageSize, extraSize), numPages_(0), numLir_(0),
+      hirFraction_(hirFraction), nonResidentRatio_(nonResidentRatio) {}
+
+LIRSReplacementPageCache::~LIRSReplacementPageCache() {
+  for (auto &[pageId, entry] : entries_) {
+    delete entry->page;
+    delete entry;
+  }
+}
+
+void LIRSReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  Entry *entry;
+  while (getNumPages() > maxNumPages_ && (entry = getVictim()) != nullptr) {
+    delete evictEntry(entry);
+  }
+
+  balanceLir();
+  trimNonResident();
+}
+
+int LIRSReplacementPageCache::getNumPages() const { return numPages_; }
+
+Page *LIRSReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, record the reference, and
+  // return the pointer. An interior page rejoins the rest of Q first.
+  auto entriesIterator = entries_.find(pageId);
+  if (entriesIterator != entries_.end() &&
+      entriesIterator->second->page != nullptr) {
+    ++numHits_;
+    Entry *entry = entriesIterator->second;
+    if (entry->interior && entry->inQueue) {
+      queue_.splice(queue_.end(), interiorQueue_, entry->queueIterator);
+    }
+    entry->interior = false;
+    accessEntry(entry);
+    entry->pinned = true;
+    return entry->page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  LIRSReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new LIRSReplacementPage(pageSize_, extraSize_);
+  } else {
+    Entry *victim = getVictim();
+    if (victim == nullptr) {
+      return nullptr;
+    }
+    page = evictEntry(victim);
+  }
+  ++numPages_;
+
+  // Replacing the victim may have forgotten a non-resident entry for the page,
+  // so look it up again. A non-resident entry still in S was referenced again
+  // within the recency of the LIR pages, so the page becomes LIR. A new page
+  // becomes LIR only while there is room for more LIR pages.
+  Entry *entry;
+  entriesIterator = entries_.find(pageId);
+  if (entriesIterator != entries_.end()) {
+    entry = entriesIterator->second;
+    nonResident_.erase(entry->queueIterator);
+    entry->inQueue = false;
+    entry->lir = true;
+    ++numLir_;
+    moveToStackTop(entry);
+  } else {
+    entry = new Entry{pageId, numLir_ < getLirTarget(), true, false, nullptr,
+                      false,  {},                         false, {}};
+    entries_.emplace(pageId, entry);
+    numLir_ += entry->lir;
+    moveToStackTop(entry);
+    if (!entry->lir) {
+      moveToQueueEnd(entry);
+    }
+  }
+  entry->page = page;
+  entry->pinned = true;
+  page->entry = entry;
+
+  balanceLir();
+  return page;
+}
+
+void LIRSReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LIRSReplacementPage *)pageBase;
+
+  // If discard is true, discard the page. If the number of pages in the cache
+  // is greater than the maximum, replace the page.
+  if (discard) {
+    discardEntry(page->entry);
+    return;
+  }
+  if (getNumPages() > maxNumPages_) {
+    page->entry->pinned = false;
+    delete evictEntry(page->entry);
+    return;
+  }
+
+  // Otherwise, unpin the page. SQLite has written the page by now, so classify
+  // it by its page-type byte. A resident HIR interior page moves to
+  // `interiorQueue_`.
+  Entry *entry = page->entry;
+  if (entry->pinned) {
+    entry->pinned = false;
+    entry->interior = isProtectedPage(page, entry->pageId);
+    if (entry->interior && entry->inQueue) {
+      interiorQueue_.splice(interiorQueue_.end(), queue_,
+                            entry->queueIterator);
+    }
+  }
+}
+
+void LIRSReplacementPageCache::changePageId(Page *pageBase,
+                                            unsigned newPageId) {
+  auto *page = (LIRSReplacementPage *)pageBase;
+
+  // If a page or non-resident entry with page ID `newPageId` exists, discard
+  // it.
+  auto entriesIterator = entries_.find(newPageId);
+  if (entriesIterator != entries_.end()) {
+    discardEntry(entriesIterator->second);
+  }
+
+  // Change the page ID.
+  entries_.erase(page->entry->pageId);
+  page->entry->pageId = newPageId;
+  entries_.emplace(newPageId, page->entry);
+}
+
+void LIRSReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages and non-resident entries with page ID greater than or
+  // equal to `pageIdLimit`. Discarding an entry can prune others from the
+  // stack, so each page ID is looked up again before it is discarded.
+  std::vector<unsigned> discarded;
+  for (auto &[pageId, entry] : entries_) {
+    if (pageId >= pageIdLimit) {
+      discarded.push_back(pageId);
+    }
+  }
+  for (unsigned pageId : discarded) {
+    auto entriesIterator = entries_.find(pageId);
+    if (entriesIterator != entries_.end()) {
+      discardEntry(entriesIterator->second);
+    }
+  }
+}
+
+int LIRSReplacementPageCache::getNumNonResident() const {
+  return (int)nonResident_.size();
+}
+
+void LIRSReplacementPageCache::accessEntry(Entry *entry) {
+  if (entry->lir) {
+    // An LIR page moves to the top of S. If it was at the bottom, S is pruned.
+    moveToStackTop(entry);
+    pruneStack();
+  } else if (entry->inStack) {
+    // A resident HIR page in S was referenced again within the recency of the
+    // LIR pages, so it becomes LIR and the bottom LIR page becomes HIR.
+    moveToStackTop(entry);
+    getQueue(entry).erase(entry->queueIterator);
+    entry->inQueue = false;
+    entry->lir = true;
+    ++numLir_;
+    balanceLir();
+  } else {
+    // A resident HIR page not in S stays HIR.
+    moveToStackTop(entry);
+    moveToQueueEnd(entry);
+  }
+}
+
+void LIRSReplacementPageCache::moveToStackTop(Entry *entry) {
+  if (entry->inStack) {
+    stack_.splice(stack_.end(), stack_, entry->stackIterator);
+  } else {
+    entry->stackIterator = stack_.insert(stack_.end(), entry);
+    entry->inStack = true;
+  }
+}
+
+void LIRSReplacementPageCache::moveToQueueEnd(Entry *entry) {
+  std::list<Entry *> &queue = getQueue(entry);
+  if (entry->inQueue) {
+    queue.splice(queue.end(), queue, entry->queueIterator);
+  } else {
+    entry->queueIterator = queue.insert(queue.end(), entry);
+    entry->inQueue = true;
+  }
+}
+
+void LIRSReplacementPageCache::balanceLir() {
+  pruneStack();
+  while (numLir_ > getLirTarget() && !stack_.empty()) {
+    Entry *entry = stack_.front();
+    stack_.pop_front();
+    entry->inStack = false;
+    entry->lir = false;
+    --numLir_;
+    moveToQueueEnd(entry);
+    pruneStack();
+  }
+}
+
+void LIRSReplacementPageCache::pruneStack() {
+  while (!stack_.empty() && !stack_.front()->lir) {
+    Entry *entry = stack_.front();
+    stack_.pop_front();
+    entry->inStack = false;
+    if (entry->page == nullptr) {
+      nonResident_.erase(entry->queueIterator);
+      entries_.erase(entry->pageId);
+      delete entry;
+    }
+  }
+}
+
+LIRSReplacementPageCache::Entry *LIRSReplacementPageCache::getVictim() const {
+  for (Entry *entry : queue_) {
+    if (!entry->pinned) {
+      return entry;
+    }
+  }
+  for (Entry *entry : stack_) {
+    if (entry->lir && !entry->pinned && !entry->interior) {
+      return entry;
+    }
+  }
+
+  // Only protected interior pages are unpinned, if any.
+  if (!interiorQueue_.empty()) {
+    return interiorQueue_.front();
+  }
+  for (Entry *entry : stack_) {
+    if (entry->lir && !entry->pinned) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+LIRSReplacementPageCache::LIRSReplacementPage *
+LIRSReplacementPageCache::evictEntry(Entry *entry) {
+  LIRSReplacementPage *page = entry->page;
+  entry->page = nullptr;
+  --numPages_;
+
+  if (entry->inQueue) {
+    getQueue(entry).erase(entry->queueIterator);
+    entry->inQueue = false;
+  }
+  entry->interior = false;
+  if (entry->lir) {
+    entry->lir = false;
+    --numLir_;
+  }
+
+  if (entry->inStack) {
+    entry->queueIterator = nonResident_.insert(nonResident_.end(), entry);
+    entry->inQueue = true;
+    pruneStack();
+    trimNonResident();
+  } else {
+    entries_.erase(entry->pageId);
+    delete entry;
+  }
+  return page;
+}
+
+std::list<LIRSReplacementPageCache::Entry *> &
+LIRSReplacementPageCache::getQueue(Entry *entry) {
+  return entry->interior ? interiorQueue_ : queue_;
+}
+
+void LIRSReplacementPageCache::trimNonResident() {
+  while ((int)nonResident_.size() > getNonResidentLimit()) {
+    Entry *entry = nonResident_.front();
+    nonResident_.pop_front();
+    stack_.erase(entry->stackIterator);
+    entries_.erase(entry->pageId);
+    delete entry;
+  }
+}
+
+void LIRSReplacementPageCache::discardEntry(Entry *entry) {
+  if (entry->page != nullptr) {
+    delete entry->page;
+    --numPages_;
+    if (entry->inQueue) {
+      getQueue(entry).erase(entry->queueIterator);
+    }
+  } else {
+    nonResident_.erase(entry->queueIterator);
+  }
+  if (entry->inStack) {
+    stack_.erase(entry->stackIterator);
+  }
+  numLir_ -= entry->lir;
+  entries_.erase(entry->pageId);
+  delete entry;
+
+  pruneStack();
+}
+
+int LIRSReplacementPageCache::getLirTarget() const {
+  int hirTarget = std::max(1, (int)(hirFraction_ * maxNumPages_));
+  return std::max(1, maxNumPages_ - hirTarget);
+}
+
+int LIRSReplacementPageCache::getNonResidentLimit() const {
+  return std::max(0, (int)(nonResidentRatio_ * maxNumPages_));
+}
@@ -0,0 +1,185 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_LIRS_HPP
+#define CS564_PROJECT_PAGE_CACHE_LIRS_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+
+/**
+ * LIRS page cache as described by Jiang and Zhang. Pages with a low
+ * inter-reference recency (LIR) are protected. Victims are taken from the
+ * queue Q of resident pages with a high inter-reference recency (HIR). The
+ * LIRS stack S orders recent references and is pruned so that its bottom is
+ * always an LIR page.
+ *
+ * Replaced HIR pages that are still in S are kept as non-resident entries so a
+ * quick return can promote them to LIR. Each non-resident entry costs one
+ * `Entry` plus a hash table node and two list nodes, and their number is
+ * bounded by `nonResidentRatio` times the maximum number of pages.
+ */
+class LIRSReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct a LIRSReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param hirFraction Fraction of the maximum number of pages reserved for
+   * resident HIR pages. At least one page is reserved.
+   * @param nonResidentRatio Maximum number of non-resident HIR entries as a
+   * multiple of the maximum number of pages.
+   */
+  LIRSReplacementPageCache(int pageSize, int extraSize,
+                           double hirFraction = 0.01,
+                           double nonResidentRatio = 1.0);
+
+  ~LIRSReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Get the number of non-resident HIR entries.
+   * @return Number of non-resident HIR entries.
+   */
+  [[nodiscard]] int getNumNonResident() const;
+
+private:
+  struct LIRSReplacementPage;
+
+  struct Entry {
+    unsigned pageId;
+    bool lir;
+    bool pinned;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Cleared when the page is fetched again. A resident HIR
+     * interior page is kept in `interiorQueue_` instead of `queue_`.
+     */
+    bool interior;
+
+    /** Null if the entry is non-resident. */
+    LIRSReplacementPage *page;
+
+    bool inStack;
+    std::list<Entry *>::iterator stackIterator;
+
+    /**
+     * Position in `queue_` or `interiorQueue_` if resident HIR, in
+     * `nonResident_` otherwise.
+     */
+    bool inQueue;
+    std::list<Entry *>::iterator queueIterator;
+  };
+
+  struct LIRSReplacementPage : public Page {
+    LIRSReplacementPage(int pageSize, int extraSize);
+
+    Entry *entry;
+  };
+
+  /**
+   * Record a hit on a resident page.
+   * @param entry Pointer to a resident entry.
+   */
+  void accessEntry(Entry *entry);
+
+  /**
+   * Move an entry to the top of S, pushing it if it is not in S.
+   * @param entry Pointer to an entry.
+   */
+  void moveToStackTop(Entry *entry);
+
+  /**
+   * Append a resident HIR entry to the end of Q, removing it from its current
+   * position first.
+   * @param entry Pointer to a resident HIR entry.
+   */
+  void moveToQueueEnd(Entry *entry);
+
+  /**
+   * Demote LIR pages from the bottom of S to HIR until the number of LIR
+   * pages is within its target.
+   */
+  void balanceLir();
+
+  /**
+   * Remove HIR entries from the bottom of S until an LIR entry is at the
+   * bottom. Non-resident entries removed from S are forgotten.
+   */
+  void pruneStack();
+
+  /**
+   * Choose a page to replace: the first unpinned page in Q, or, if every page
+   * in Q is pinned, the unpinned LIR page nearest the bottom of S. Protected
+   * interior pages are only chosen if no other page is unpinned, first from
+   * the interior part of Q and then from S.
+   * @return Pointer to an entry. Null if all pages are pinned.
+   */
+  [[nodiscard]] Entry *getVictim() const;
+
+  /**
+   * Replace the page of a resident entry. The entry becomes a non-resident
+   * HIR entry if it is in S and is forgotten otherwise.
+   * @param entry Pointer to a resident, unpinned entry.
+   * @return Pointer to the replaced page.
+   */
+  LIRSReplacementPage *evictEntry(Entry *entry);
+
+  /**
+   * Get the part of Q that holds a resident HIR entry.
+   * @param entry Pointer to a resident HIR entry.
+   * @return `interiorQueue_` for interior pages, `queue_` otherwise.
+   */
+  std::list<Entry *> &getQueue(Entry *entry);
+
+  /**
+   * Forget the oldest non-resident entries beyond the configured bound.
+   */
+  void trimNonResident();
+
+  /**
+   * Remove an entry from every structure and free it and its page.
+   * @param entry Pointer to an entry.
+   */
+  void discardEntry(Entry *entry);
+
+  [[nodiscard]] int getLirTarget() const;
+
+  [[nodiscard]] int getNonResidentLimit() const;
+
+  /** Resident and non-resident entries, by page ID. */
+  std::unordered_map<unsigned, Entry *> entries_;
+
+  /** LIRS stack S. The back is the top. */
+  std::list<Entry *> stack_;
+
+  /** Resident HIR pages. The front is replaced first. */
+  std::list<Entry *> queue_;
+
+  /**
+   * Unpinned resident HIR pages that are protected interior pages, least
+   * recently unpinned first. Empty unless interior pages are protected.
+   */
+  std::list<Entry *> interiorQueue_;
+
+  /** Non-resident HIR entries, oldest first. */
+  std::list<Entry *> nonResident_;
+
+  int numPages_;
+  int numLir_;
+  double hirFraction_;
+  double nonResidentRatio_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_LIRS_HPP
@@ -0,0 +1,240 @@
+#include "page_cache_lrfu.hpp"
+
+#include <cmath>
+#include <utility>
+
+LRFUReplacementPageCache::LRFUReplacementPage::LRFUReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      crf(0.0), lastTime(0), interior(false), heapIndex(-1) {}
+
+LRFUReplacementPageCache::LRFUReplacementPageCache(int pageSize, int extraSize,
+                                                   double lambda)
+    : PageCache(pageSize, extraSize), time_(0), lambda_(lambda) {}
+
+LRFUReplacementPageCache::~LRFUReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void LRFUReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Discard the unpinned pages with the lowest CRF until the number of pages in
+  // the cache is less than or equal to `maxNumPages_` or only pinned pages
+  // remain.
+  LRFUReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = getVictim()) != nullptr) {
+    discardPage(page);
+  }
+}
+
+int LRFUReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *LRFUReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+  ++time_;
+
+  // If the page is already in the cache, pin it, record the fetch, and return
+  // the pointer. A pinned page is never a candidate for replacement, so take it
+  // out of the heap.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    LRFUReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      removeHeap(page);
+      page->pinned = true;
+    }
+    accessPage(page);
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace the unpinned page
+  // with the lowest CRF. If all pages are pinned, return a null pointer.
+  LRFUReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new LRFUReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = getVictim();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    removeHeap(page);
+    pages_.erase(page->pageId);
+    page->pageId = pageId;
+    page->pinned = true;
+    page->crf = 0.0;
+  }
+  pages_.emplace(pageId, page);
+  accessPage(page);
+  return page;
+}
+
+void LRFUReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LRFUReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page and add it to the heap. SQLite has written the
+  // page by now, so classify it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+    page->interior = isProtectedPage(page, page->pageId);
+    pushHeap(page);
+  }
+}
+
+void LRFUReplacementPageCache::changePageId(Page *pageBase,
+                                            unsigned newPageId) {
+  auto *page = (LRFUReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    LRFUReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    if (!oldPage->pinned) {
+      removeHeap(oldPage);
+    }
+    delete oldPage;
+  }
+}
+
+void LRFUReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    LRFUReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (!page->pinned) {
+        removeHeap(page);
+      }
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+void LRFUReplacementPageCache::setLambda(double lambda) {
+  lambda_ = lambda;
+  for (auto *heap : {&heap_, &interiorHeap_}) {
+    for (int index = (int)heap->size() / 2 - 1; index >= 0; --index) {
+      siftDown(*heap, index);
+    }
+  }
+}
+
+double LRFUReplacementPageCache::getLambda() const { return lambda_; }
+
+void LRFUReplacementPageCache::accessPage(LRFUReplacementPage *page) {
+  page->crf = 1.0 + std::exp2(-lambda_ * (double)(time_ - page->lastTime)) *
+                        page->crf;
+  page->lastTime = time_;
+}
+
+double LRFUReplacementPageCache::getKey(const LRFUReplacementPage *page) const {
+  return std::log2(page->crf) + lambda_ * (double)page->lastTime;
+}
+
+LRFUReplacementPageCache::LRFUReplacementPage *
+LRFUReplacementPageCache::getVictim() const {
+  if (!heap_.empty()) {
+    return heap_.front();
+  }
+  return !interiorHeap_.empty() ? interiorHeap_.front() : nullptr;
+}
+
+std::vector<LRFUReplacementPageCache::LRFUReplacementPage *> &
+LRFUReplacementPageCache::getHeap(const LRFUReplacementPage *page) {
+  return page->interior ? interiorHeap_ : heap_;
+}
+
+void LRFUReplacementPageCache::pushHeap(LRFUReplacementPage *page) {
+  std::vector<LRFUReplacementPage *> &heap = getHeap(page);
+  page->heapIndex = (int)heap.size();
+  heap.push_back(page);
+  siftUp(heap, page->heapIndex);
+}
+
+void LRFUReplacementPageCache::removeHeap(LRFUReplacementPage *page) {
+  std::vector<LRFUReplacementPage *> &heap = getHeap(page);
+  int index = page->heapIndex;
+  int last = (int)heap.size() - 1;
+  if (index != last) {
+    swapHeap(heap, index, last);
+  }
+  heap.pop_back();
+  page->heapIndex = -1;
+  if (index != last) {
+    siftDown(heap, index);
+    siftUp(heap, index);
+  }
+}
+
+void LRFUReplacementPageCache::siftUp(std::vector<LRFUReplacementPage *> &heap,
+                                      int index) {
+  while (index > 0) {
+    int parent = (index - 1) / 2;
+    if (getKey(heap[parent]) <= getKey(heap[index])) {
+      break;
+    }
+    swapHeap(heap, index, parent);
+    index = parent;
+  }
+}
+
+void LRFUReplacementPageCache::siftDown(
+    std::vector<LRFUReplacementPage *> &heap, int index) {
+  int size = (int)heap.size();
+  while (true) {
+    int smallest = index;
+    for (int child = 2 * index + 1; child <= 2 * index + 2; ++child) {
+      if (child < size && getKey(heap[child]) < getKey(heap[smallest])) {
+        smallest = child;
+      }
+    }
+    if (smallest == index) {
+      break;
+    }
+    swapHeap(heap, index, smallest);
+    index = smallest;
+  }
+}
+
+void LRFUReplacementPageCache::swapHeap(
+    std::vector<LRFUReplacementPage *> &heap, int index1, int index2) {
+  std::swap(heap[index1], heap[index2]);
+  heap[index1]->heapIndex = index1;
+  heap[index2]->heapIndex = index2;
+}
+
+void LRFUReplacementPageCache::discardPage(LRFUReplacementPage *page) {
+  if (!page->pinned) {
+    removeHeap(page);
+  }
+  pages_.erase(page->pageId);
+  delete page;
+}
@@ -0,0 +1,133 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_LRFU_HPP
+#define CS564_PROJECT_PAGE_CACHE_LRFU_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * LRFU page cache as described by Lee et al. Each page has a Combined Recency
+ * and Frequency (CRF) value: the sum of `2^(-lambda * t)` over its past
+ * fetches, where `t` is the number of fetches since each one. The page with the
+ * lowest CRF is replaced. With `lambda` equal to 0 this is LFU, and with
+ * `lambda` equal to 1 it is LRU.
+ *
+ * All CRF values decay by the same factor as time passes, so the order of
+ * unpinned pages only changes when they are fetched. Unpinned pages are kept in
+ * a binary min-heap keyed by `log2(crf) + lambda * lastTime`, which orders
+ * pages the same way as their CRF values at any common time.
+ */
+class LRFUReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct an LRFUReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param lambda Decay rate, from 0 (LFU) to 1 (LRU).
+   */
+  LRFUReplacementPageCache(int pageSize, int extraSize, double lambda = 0.001);
+
+  ~LRFUReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Set the decay rate. The heap is rebuilt, since its keys depend on it.
+   * @param lambda Decay rate, from 0 (LFU) to 1 (LRU).
+   */
+  void setLambda(double lambda);
+
+  /**
+   * Get the decay rate.
+   * @return Decay rate.
+   */
+  [[nodiscard]] double getLambda() const;
+
+private:
+  struct LRFUReplacementPage : public Page {
+    LRFUReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** CRF value as of `lastTime`. */
+    double crf;
+    unsigned long long lastTime;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Protected pages are kept in `interiorHeap_`.
+     */
+    bool interior;
+
+    /** Position in `heap_` or `interiorHeap_`. -1 while pinned. */
+    int heapIndex;
+  };
+
+  /**
+   * Record a fetch of a page at the current time.
+   * @param page Pointer to a page.
+   */
+  void accessPage(LRFUReplacementPage *page);
+
+  [[nodiscard]] double getKey(const LRFUReplacementPage *page) const;
+
+  /**
+   * Choose a page to replace: the unpinned page with the lowest CRF. Protected
+   * interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page in `heap_` or `interiorHeap_`. Null if all pages
+   * are pinned.
+   */
+  [[nodiscard]] LRFUReplacementPage *getVictim() const;
+
+  /**
+   * Get the heap that holds a page while it is unpinned.
+   * @param page Pointer to a page.
+   * @return `interiorHeap_` for interior pages, `heap_` otherwise.
+   */
+  std::vector<LRFUReplacementPage *> &getHeap(const LRFUReplacementPage *page);
+
+  void pushHeap(LRFUReplacementPage *page);
+
+  void removeHeap(LRFUReplacementPage *page);
+
+  void siftUp(std::vector<LRFUReplacementPage *> &heap, int index);
+
+  void siftDown(std::vector<LRFUReplacementPage *> &heap, int index);
+
+  void swapHeap(std::vector<LRFUReplacementPage *> &heap, int index1,
+                int index2);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(LRFUReplacementPage *page);
+
+  std::unordered_map<unsigned, LRFUReplacementPage *> pages_;
+
+  /** Min-heap of unpinned pages. The front has the lowest CRF. */
+  std::vector<LRFUReplacementPage *> heap_;
+
+  /**
+   * Min-heap of unpinned protected interior pages. Empty unless interior pages
+   * are protected.
+   */
+  std::vector<LRFUReplacementPage *> interiorHeap_;
+
+  unsigned long long time_;
+  double lambda_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_LRFU_HPP
@@ -1,39 +1,164 @@
 #include "page_cache_lru.hpp"
-#include "utilities/exception.hpp"
+
+LRUReplacementPageCache::LRUReplacementPage::LRUReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId, bool argPinned)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(argPinned),
+      interior(false), prev(nullptr), next(nullptr) {}
 
 LRUReplacementPageCache::LRUReplacementPageCache(int pageSize, int extraSize)
-    : PageCache(pageSize, extraSize) {
-  // TODO: Implement.
-  throw NotImplementedException(
-      "LRUReplacementPageCache::LRUReplacementPageCache");
+    : PageCache(pageSize, extraSize), head_(nullptr), tail_(nullptr),
+      interiorHead_(nullptr), interiorTail_(nullptr) {}
+
+LRUReplacementPageCache::~LRUReplacementPageCache() {
+  pages_.forEach([](LRUReplacementPage *page) { delete page; });
 }
 
 void LRUReplacementPageCache::setMaxNumPages(int maxNumPages) {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::setMaxNumPages");
-}
+  maxNumPages_ = maxNumPages;
 
-int LRUReplacementPageCache::getNumPages() const {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::getNumPages");
+  // Discard the least recently unpinned pages until the number of pages in the
+  // cache is less than or equal to `maxNumPages_` or only pinned pages remain.
+  // Interior pages are discarded last if they are protected.
+  LRUReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = getVictim()) != nullptr) {
+    discardPage(page);
+  }
 }
 
+int LRUReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
 Page *LRUReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::fetchPage");
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. A
+  // pinned page is never a candidate for replacement, so take it out of the
+  // list of unpinned pages.
+  if (LRUReplacementPage *page = pages_.find(pageId)) {
+    ++numHits_;
+    if (!page->pinned) {
+      removeUnpinned(page);
+      page->pinned = true;
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate and return a pointer to a new page.
+  if (getNumPages() < maxNumPages_) {
+    auto page = new LRUReplacementPage(pageSize_, extraSize_, pageId, true);
+    pages_.insert(pageId, page);
+    return page;
+  }
+
+  // The number of pages in the cache is greater than or equal to the maximum.
+  // If all pages are pinned, return a null pointer.
+  LRUReplacementPage *page = getVictim();
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  // Replace the least recently unpinned page, preferring pages that are not
+  // protected interior pages.
+  removeUnpinned(page);
+  pages_.erase(page->pageId);
+  page->pageId = pageId;
+  page->pinned = true;
+  pages_.insert(pageId, page);
+  return page;
 }
 
-void LRUReplacementPageCache::unpinPage(Page *page, bool discard) {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::unpinPage");
+void LRUReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LRUReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page. Otherwise, unpin the page and make it the most
+  // recently unpinned page. SQLite has written the page by now, so classify it
+  // by its page-type byte.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+  } else {
+    if (!page->pinned) {
+      removeUnpinned(page);
+    }
+    page->pinned = false;
+    page->interior = isProtectedPage(page, page->pageId);
+    pushUnpinned(page);
+  }
 }
 
-void LRUReplacementPageCache::changePageId(Page *page, unsigned newPageId) {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::changePageId");
+void LRUReplacementPageCache::changePageId(Page *pageBase, unsigned newPageId) {
+  auto *page = (LRUReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Insert the page with page ID `newPageId` into `pages_`. If a page with
+  // page ID `newPageId` is already in the cache, discard it.
+  LRUReplacementPage *oldPage = pages_.exchange(newPageId, page);
+  if (oldPage != nullptr) {
+    if (!oldPage->pinned) {
+      removeUnpinned(oldPage);
+    }
+    delete oldPage;
+  }
 }
 
 void LRUReplacementPageCache::discardPages(unsigned pageIdLimit) {
-  // TODO: Implement.
-  throw NotImplementedException("LRUReplacementPageCache::discardPages");
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  pages_.eraseFrom(pageIdLimit, [this](LRUReplacementPage *page) {
+    if (!page->pinned) {
+      removeUnpinned(page);
+    }
+    delete page;
+  });
+}
+
+void LRUReplacementPageCache::pushUnpinned(LRUReplacementPage *page) {
+  LRUReplacementPage *&head = page->interior ? interiorHead_ : head_;
+  LRUReplacementPage *&tail = page->interior ? interiorTail_ : tail_;
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void LRUReplacementPageCache::removeUnpinned(LRUReplacementPage *page) {
+  LRUReplacementPage *&head = page->interior ? interiorHead_ : head_;
+  LRUReplacementPage *&tail = page->interior ? interiorTail_ : tail_;
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+LRUReplacementPageCache::LRUReplacementPage *
+LRUReplacementPageCache::getVictim() const {
+  return head_ != nullptr ? head_ : interiorHead_;
+}
+
+void LRUReplacementPageCache::discardPage(LRUReplacementPage *page) {
+  if (!page->pinned) {
+    removeUnpinned(page);
+  }
+  pages_.erase(page->pageId);
+  delete page;
 }
@@ -2,11 +2,14 @@
 #define CS564_PROJECT_PAGE_CACHE_LRU_HPP
 
 #include "page_cache.hpp"
+#include "page_index.hpp"
 
 class LRUReplacementPageCache : public PageCache {
 public:
   LRUReplacementPageCache(int pageSize, int extraSize);
 
+  ~LRUReplacementPageCache() override;
+
   void setMaxNumPages(int maxNumPages) override;
 
   [[nodiscard]] int getNumPages() const override;
@@ -20,7 +23,63 @@ public:
   void discardPages(unsigned int pageIdLimit) override;
 
 private:
-  // TODO: Declare class members as needed.
+  struct LRUReplacementPage : public Page {
+    LRUReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                       bool pinned);
+
+    unsigned pageId;
+    bool pinned;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned.
+     */
+    bool interior;
+
+    /** Neighbors in the list of unpinned pages. Null while pinned. */
+    LRUReplacementPage *prev;
+    LRUReplacementPage *next;
+  };
+
+  /**
+   * Append an unpinned page to the most recently unpinned end of its list.
+   * @param page Pointer to a page.
+   */
+  void pushUnpinned(LRUReplacementPage *page);
+
+  /**
+   * Remove a page from its list of unpinned pages.
+   * @param page Pointer to a page. Must be in the list.
+   */
+  void removeUnpinned(LRUReplacementPage *page);
+
+  /**
+   * Get the next page to replace. Unpinned interior pages are only replaced
+   * when no other unpinned pages remain.
+   * @return Pointer to a page, or a null pointer if all pages are pinned.
+   */
+  [[nodiscard]] LRUReplacementPage *getVictim() const;
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(LRUReplacementPage *page);
+
+  PageIndex<LRUReplacementPage> pages_;
+
+  /** Least recently unpinned page. Replaced first. */
+  LRUReplacementPage *head_;
+
+  /** Most recently unpinned page. */
+  LRUReplacementPage *tail_;
+
+  /**
+   * Least and most recently unpinned protected interior pages, kept in a
+   * separate list. Empty unless interior pages are protected.
+   */
+  LRUReplacementPage *interiorHead_;
+  LRUReplacementPage *interiorTail_;
 };
 
 #endif // CS564_PROJECT_PAGE_CACHE_LRU_HPP
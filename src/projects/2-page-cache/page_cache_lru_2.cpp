@@ -1,38 +1,217 @@
 #include "page_cache_lru_2.hpp"
-#include "utilities/exception.hpp"
+
+LRU2ReplacementPageCache::LRU2ReplacementPage::LRU2ReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId, bool argPinned)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(argPinned),
+      interior(false), unpinTimes{0, 0}, prev(nullptr), next(nullptr) {}
 
 LRU2ReplacementPageCache::LRU2ReplacementPageCache(int pageSize, int extraSize)
-    : PageCache(pageSize, extraSize) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::LRU2ReplacementPageCache");
+    : PageCache(pageSize, extraSize), onceHead_(nullptr), onceTail_(nullptr),
+      interiorOnceHead_(nullptr), interiorOnceTail_(nullptr), time_(0) {}
+
+LRU2ReplacementPageCache::~LRU2ReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
 }
 
 void LRU2ReplacementPageCache::setMaxNumPages(int maxNumPages) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::setMaxNumPages");
+  maxNumPages_ = maxNumPages;
+
+  // Discard unpinned pages in replacement order until the number of pages in
+  // the cache is less than or equal to `maxNumPages_` or only pinned pages
+  // remain.
+  LRU2ReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = getVictim()) != nullptr) {
+    discardPage(page);
+  }
 }
 
 int LRU2ReplacementPageCache::getNumPages() const {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::getNumPages");
+  return (int)pages_.size();
 }
 
 Page *LRU2ReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::fetchPage");
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    LRU2ReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      removeUnpinned(page);
+      page->pinned = true;
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate and return a pointer to a new page.
+  if (getNumPages() < maxNumPages_) {
+    auto page = new LRU2ReplacementPage(pageSize_, extraSize_, pageId, true);
+    pages_.emplace(pageId, page);
+    return page;
+  }
+
+  // The number of pages in the cache is greater than or equal to the maximum.
+  // If all pages are pinned, return a null pointer.
+  LRU2ReplacementPage *page = getVictim();
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  // Replace the victim. Its unpin history belongs to the old page ID.
+  removeUnpinned(page);
+  pages_.erase(page->pageId);
+  page->pageId = pageId;
+  page->pinned = true;
+  page->interior = false;
+  page->unpinTimes[0] = 0;
+  page->unpinTimes[1] = 0;
+  pages_.emplace(pageId, page);
+  return page;
 }
 
-void LRU2ReplacementPageCache::unpinPage(Page *page, bool discard) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::unpinPage");
+void LRU2ReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LRU2ReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page and record the time of the unpin. SQLite has
+  // written the page by now, so classify it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+  } else {
+    removeUnpinned(page);
+  }
+  page->interior = isProtectedPage(page, page->pageId);
+  page->unpinTimes[1] = page->unpinTimes[0];
+  page->unpinTimes[0] = ++time_;
+  pushUnpinned(page);
 }
 
-void LRU2ReplacementPageCache::changePageId(Page *page, unsigned newPageId) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::changePageId");
+void LRU2ReplacementPageCache::changePageId(Page *pageBase,
+                                            unsigned newPageId) {
+  auto *page = (LRU2ReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    LRU2ReplacementPage *oldPage = pagesIterator->second;
+    if (!oldPage->pinned) {
+      removeUnpinned(oldPage);
+    }
+    delete oldPage;
+    pagesIterator->second = page;
+  }
 }
 
 void LRU2ReplacementPageCache::discardPages(unsigned pageIdLimit) {
-  // TODO: Implement.
-  throw NotImplementedException("LRU2ReplacementPageCache::discardPages");
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    LRU2ReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (!page->pinned) {
+        removeUnpinned(page);
+      }
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+void LRU2ReplacementPageCache::pushUnpinned(LRU2ReplacementPage *page) {
+  if (page->unpinTimes[1] != 0) {
+    TwiceUnpinnedSet &twiceUnpinned =
+        page->interior ? interiorTwiceUnpinned_ : twiceUnpinned_;
+    page->twiceUnpinnedIterator =
+        twiceUnpinned.emplace(page->unpinTimes[1], page).first;
+    return;
+  }
+
+  LRU2ReplacementPage *&onceHead =
+      page->interior ? interiorOnceHead_ : onceHead_;
+  LRU2ReplacementPage *&onceTail =
+      page->interior ? interiorOnceTail_ : onceTail_;
+  page->prev = onceTail;
+  page->next = nullptr;
+  if (onceTail != nullptr) {
+    onceTail->next = page;
+  } else {
+    onceHead = page;
+  }
+  onceTail = page;
+}
+
+void LRU2ReplacementPageCache::removeUnpinned(LRU2ReplacementPage *page) {
+  if (page->unpinTimes[1] != 0) {
+    TwiceUnpinnedSet &twiceUnpinned =
+        page->interior ? interiorTwiceUnpinned_ : twiceUnpinned_;
+    twiceUnpinned.erase(page->twiceUnpinnedIterator);
+    return;
+  }
+
+  LRU2ReplacementPage *&onceHead =
+      page->interior ? interiorOnceHead_ : onceHead_;
+  LRU2ReplacementPage *&onceTail =
+      page->interior ? interiorOnceTail_ : onceTail_;
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    onceHead = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    onceTail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+LRU2ReplacementPageCache::LRU2ReplacementPage *
+LRU2ReplacementPageCache::getVictim() const {
+  if (onceHead_ != nullptr) {
+    return onceHead_;
+  }
+  if (!twiceUnpinned_.empty()) {
+    return twiceUnpinned_.begin()->second;
+  }
+
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (interiorOnceHead_ != nullptr) {
+    return interiorOnceHead_;
+  }
+  if (!interiorTwiceUnpinned_.empty()) {
+    return interiorTwiceUnpinned_.begin()->second;
+  }
+  return nullptr;
+}
+
+void LRU2ReplacementPageCache::discardPage(LRU2ReplacementPage *page) {
+  if (!page->pinned) {
+    removeUnpinned(page);
+  }
+  pages_.erase(page->pageId);
+  delete page;
 }
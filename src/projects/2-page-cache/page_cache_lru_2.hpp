@@ -3,10 +3,16 @@
 
 #include "page_cache.hpp"
 
+#include <set>
+#include <unordered_map>
+#include <utility>
+
 class LRU2ReplacementPageCache : public PageCache {
 public:
   LRU2ReplacementPageCache(int pageSize, int extraSize);
 
+  ~LRU2ReplacementPageCache() override;
+
   void setMaxNumPages(int maxNumPages) override;
 
   [[nodiscard]] int getNumPages() const override;
@@ -20,7 +26,88 @@ public:
   void discardPages(unsigned int pageIdLimit) override;
 
 private:
-  // TODO: Declare class members as needed.
+  struct LRU2ReplacementPage;
+
+  /** Pages unpinned at least twice, keyed by second most recent unpin. */
+  using TwiceUnpinnedSet =
+      std::set<std::pair<unsigned long long, LRU2ReplacementPage *>>;
+
+  struct LRU2ReplacementPage : public Page {
+    LRU2ReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                        bool pinned);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    /**
+     * Times of the most recent and second most recent unpins, in that order.
+     * Zero if the page has not been unpinned that many times.
+     */
+    unsigned long long unpinTimes[2];
+
+    /**
+     * Neighbors in the list of unpinned pages that have been unpinned only
+     * once. Null otherwise.
+     */
+    LRU2ReplacementPage *prev;
+    LRU2ReplacementPage *next;
+
+    /**
+     * Position in `twiceUnpinned_` if the page is unpinned and has been
+     * unpinned at least twice, so that it can be removed without a lookup.
+     */
+    TwiceUnpinnedSet::iterator twiceUnpinnedIterator;
+  };
+
+  /**
+   * Make an unpinned page a candidate for replacement. Pages unpinned only
+   * once are appended to `onceHead_`/`onceTail_`. Other pages are inserted in
+   * `twiceUnpinned_` ordered by second most recent unpin. Protected interior
+   * pages go to the interior counterparts of these instead.
+   * @param page Pointer to a page.
+   */
+  void pushUnpinned(LRU2ReplacementPage *page);
+
+  /**
+   * Remove a page from the candidates for replacement.
+   * @param page Pointer to an unpinned page.
+   */
+  void removeUnpinned(LRU2ReplacementPage *page);
+
+  /**
+   * Get the unpinned page whose second most recent unpin is furthest in the
+   * past, preferring pages unpinned only once in least recently unpinned
+   * order. Protected interior pages are only chosen if no other page is
+   * unpinned.
+   * @return Pointer to a page. Null if all pages are pinned.
+   */
+  [[nodiscard]] LRU2ReplacementPage *getVictim() const;
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(LRU2ReplacementPage *page);
+
+  std::unordered_map<unsigned, LRU2ReplacementPage *> pages_;
+
+  /** Least and most recently unpinned pages that were unpinned once. */
+  LRU2ReplacementPage *onceHead_;
+  LRU2ReplacementPage *onceTail_;
+
+  /** Pages unpinned at least twice, keyed by second most recent unpin. */
+  TwiceUnpinnedSet twiceUnpinned_;
+
+  /** Counterparts of the above for protected interior pages. */
+  LRU2ReplacementPage *interiorOnceHead_;
+  LRU2ReplacementPage *interiorOnceTail_;
+  TwiceUnpinnedSet interiorTwiceUnpinned_;
+
+  /** Logical clock incremented on every unpin. */
+  unsigned long long time_;
 };
 
 #endif // CS564_PROJECT_PAGE_CACHE_LRU_2_HPP
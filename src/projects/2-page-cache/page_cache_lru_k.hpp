@@ -0,0 +1,468 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_LRU_K_HPP
+#define CS564_PROJECT_PAGE_CACHE_LRU_K_HPP
+
+#include "page_cache.hpp"
+
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * LRU-K page cache as described by O'Neil, O'Neil, and Weikum. Time is
+ * measured in unpins, so the Correlated Reference Period and the Retained
+ * Information Period are both numbers of unpins.
+ * @tparam K Number of references used to order pages.
+ */
+template <unsigned K> class LRUKReplacementPageCache : public PageCache {
+  static_assert(K >= 1, "LRU-K requires at least one reference");
+
+public:
+  /**
+   * Construct an LRUKReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param correlatedReferencePeriod An unpin within this many unpins of the
+   * previous unpin of the same page is correlated and does not count as a new
+   * reference. Zero disables correlation.
+   * @param retainedInformationPeriod History of a replaced page is kept for
+   * this many unpins after its last unpin. Zero disables retention.
+   */
+  LRUKReplacementPageCache(int pageSize, int extraSize,
+                           unsigned long long correlatedReferencePeriod = 0,
+                           unsigned long long retainedInformationPeriod = 0);
+
+  ~LRUKReplacementPageCache() override;
+
+  /**
+   * Set the Correlated Reference Period.
+   * @param correlatedReferencePeriod Period in unpins.
+   */
+  void setCorrelatedReferencePeriod(
+      unsigned long long correlatedReferencePeriod);
+
+  /**
+   * Set the Retained Information Period. History that falls outside the new
+   * period is dropped immediately.
+   * @param retainedInformationPeriod Period in unpins.
+   */
+  void setRetainedInformationPeriod(
+      unsigned long long retainedInformationPeriod);
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned int pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned int newPageId) override;
+
+  void discardPages(unsigned int pageIdLimit) override;
+
+private:
+  struct History {
+    /**
+     * Times of the K most recent uncorrelated references, most recent first.
+     * Zero if the page has not been referenced that many times.
+     */
+    std::array<unsigned long long, K> times{};
+
+    /** Time of the most recent unpin, correlated or not. */
+    unsigned long long last = 0;
+  };
+
+  struct LRUKReplacementPage : public Page {
+    LRUKReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                        bool pinned);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    History history;
+  };
+
+  /**
+   * Replacement order of an unpinned page. Pages are ordered by their K-th
+   * most recent reference. Pages with fewer than K references compare as
+   * zero and fall back to least recently referenced order.
+   */
+  using Key = std::pair<unsigned long long, unsigned long long>;
+
+  using UnpinnedMap = std::map<Key, LRUKReplacementPage *>;
+
+  [[nodiscard]] static Key getKey(const History &history);
+
+  /**
+   * Get the map of unpinned pages that holds a page.
+   * @param page Pointer to an unpinned page.
+   * @return `interiorUnpinned_` if the page is interior, `unpinned_`
+   * otherwise.
+   */
+  UnpinnedMap &getUnpinned(LRUKReplacementPage *page);
+
+  /**
+   * Check whether a page is inside its Correlated Reference Period, meaning
+   * that an unpin at the next time would be correlated with its last unpin.
+   * A page inside its period is not replaced if any other page can be.
+   * @param history History of the page.
+   * @return True if the page is inside its Correlated Reference Period.
+   */
+  [[nodiscard]] bool isCorrelated(const History &history) const;
+
+  /**
+   * Record an unpin in a page's history.
+   * @param history History of the unpinned page.
+   */
+  void recordUnpin(History &history);
+
+  /**
+   * Get the unpinned page with the oldest K-th most recent reference that is
+   * outside its Correlated Reference Period. At most
+   * `correlatedReferencePeriod_` pages are skipped, because only that many
+   * pages can have been unpinned within the period. If every unpinned page is
+   * inside its period, the first page in replacement order is returned.
+   * Protected interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page. Null if all pages are pinned.
+   */
+  [[nodiscard]] LRUKReplacementPage *getVictim() const;
+
+  /**
+   * Remember the history of a page that is being replaced.
+   * @param pageId Page ID of the replaced page.
+   * @param history History of the replaced page.
+   */
+  void retainHistory(unsigned pageId, const History &history);
+
+  /**
+   * Drop retained history whose last unpin is older than
+   * `retainedInformationPeriod_`.
+   */
+  void purgeHistory();
+
+  /**
+   * Take the retained history of a page ID, if any.
+   * @param pageId Page ID.
+   * @return Retained history, or an empty history.
+   */
+  History takeHistory(unsigned pageId);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(LRUKReplacementPage *page);
+
+  std::unordered_map<unsigned, LRUKReplacementPage *> pages_;
+
+  /** Unpinned pages in replacement order. */
+  UnpinnedMap unpinned_;
+
+  /** Unpinned protected interior pages in replacement order. */
+  UnpinnedMap interiorUnpinned_;
+
+  /** History of replaced pages, by page ID. */
+  std::unordered_map<unsigned, History> retained_;
+
+  /** Page IDs in `retained_`, by time of last unpin. */
+  std::map<unsigned long long, unsigned> retainedByLast_;
+
+  unsigned long long correlatedReferencePeriod_;
+  unsigned long long retainedInformationPeriod_;
+
+  /** Logical clock incremented on every unpin. */
+  unsigned long long time_;
+};
+
+template <unsigned K>
+LRUKReplacementPageCache<K>::LRUKReplacementPage::LRUKReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId, bool argPinned)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(argPinned),
+      interior(false) {}
+
+template <unsigned K>
+LRUKReplacementPageCache<K>::LRUKReplacementPageCache(
+    int pageSize, int extraSize, unsigned long long correlatedReferencePeriod,
+    unsigned long long retainedInformationPeriod)
+    : PageCache(pageSize, extraSize),
+      correlatedReferencePeriod_(correlatedReferencePeriod),
+      retainedInformationPeriod_(retainedInformationPeriod), time_(0) {}
+
+template <unsigned K> LRUKReplacementPageCache<K>::~LRUKReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::setCorrelatedReferencePeriod(
+    unsigned long long correlatedReferencePeriod) {
+  // Replacement order does not depend on the period, so `unpinned_` and
+  // `interiorUnpinned_` stay valid.
+  correlatedReferencePeriod_ = correlatedReferencePeriod;
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::setRetainedInformationPeriod(
+    unsigned long long retainedInformationPeriod) {
+  retainedInformationPeriod_ = retainedInformationPeriod;
+  purgeHistory();
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  LRUKReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = getVictim()) != nullptr) {
+    retainHistory(page->pageId, page->history);
+    discardPage(page);
+  }
+}
+
+template <unsigned K> int LRUKReplacementPageCache<K>::getNumPages() const {
+  return (int)pages_.size();
+}
+
+template <unsigned K>
+Page *LRUKReplacementPageCache<K>::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    LRUKReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      getUnpinned(page).erase(getKey(page->history));
+      page->pinned = true;
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate and return a pointer to a new page.
+  if (getNumPages() < maxNumPages_) {
+    auto page = new LRUKReplacementPage(pageSize_, extraSize_, pageId, true);
+    page->history = takeHistory(pageId);
+    pages_.emplace(pageId, page);
+    return page;
+  }
+
+  // The number of pages in the cache is greater than or equal to the maximum.
+  // If all pages are pinned, return a null pointer.
+  LRUKReplacementPage *page = getVictim();
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  // Replace the victim, retaining its history and restoring any history the
+  // new page ID left behind when it was last replaced.
+  getUnpinned(page).erase(getKey(page->history));
+  pages_.erase(page->pageId);
+  retainHistory(page->pageId, page->history);
+  page->pageId = pageId;
+  page->pinned = true;
+  page->interior = false;
+  page->history = takeHistory(pageId);
+  pages_.emplace(pageId, page);
+  return page;
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (LRUKReplacementPage *)pageBase;
+
+  // If discard is true, discard the page.
+  if (discard) {
+    discardPage(page);
+    return;
+  }
+
+  // If the number of pages in the cache is greater than the maximum, replace
+  // the page, retaining its history.
+  if (getNumPages() > maxNumPages_) {
+    retainHistory(page->pageId, page->history);
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page and record the reference. SQLite has written
+  // the page by now, so classify it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+  } else {
+    getUnpinned(page).erase(getKey(page->history));
+  }
+  recordUnpin(page->history);
+  page->interior = isProtectedPage(page, page->pageId);
+  getUnpinned(page).emplace(getKey(page->history), page);
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::changePageId(Page *pageBase,
+                                               unsigned newPageId) {
+  auto *page = (LRUKReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID. Any history
+  // retained for the new page ID describes a different page.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  takeHistory(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    LRUKReplacementPage *oldPage = pagesIterator->second;
+    if (!oldPage->pinned) {
+      getUnpinned(oldPage).erase(getKey(oldPage->history));
+    }
+    delete oldPage;
+    pagesIterator->second = page;
+  }
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    LRUKReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (!page->pinned) {
+        getUnpinned(page).erase(getKey(page->history));
+      }
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so neither does their history.
+  for (auto retainedIterator = retained_.begin();
+       retainedIterator != retained_.end();) {
+    if (retainedIterator->first >= pageIdLimit) {
+      retainedByLast_.erase(retainedIterator->second.last);
+      retainedIterator = retained_.erase(retainedIterator);
+    } else {
+      ++retainedIterator;
+    }
+  }
+}
+
+template <unsigned K>
+typename LRUKReplacementPageCache<K>::Key
+LRUKReplacementPageCache<K>::getKey(const History &history) {
+  return {history.times[K - 1], history.times[0]};
+}
+
+template <unsigned K>
+typename LRUKReplacementPageCache<K>::UnpinnedMap &
+LRUKReplacementPageCache<K>::getUnpinned(LRUKReplacementPage *page) {
+  return page->interior ? interiorUnpinned_ : unpinned_;
+}
+
+template <unsigned K>
+bool LRUKReplacementPageCache<K>::isCorrelated(const History &history) const {
+  return history.last != 0 &&
+         time_ - history.last < correlatedReferencePeriod_;
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::recordUnpin(History &history) {
+  // A correlated unpin only extends the current correlated period.
+  bool correlated = isCorrelated(history);
+  ++time_;
+  if (correlated) {
+    history.last = time_;
+    return;
+  }
+
+  // An uncorrelated unpin closes the correlated period, which collapses to a
+  // single reference by shifting the older references forward by its length.
+  unsigned long long correlatedPeriod = history.last - history.times[0];
+  for (unsigned i = K - 1; i > 0; --i) {
+    history.times[i] =
+        history.times[i - 1] != 0 ? history.times[i - 1] + correlatedPeriod
+                                  : 0;
+  }
+  history.times[0] = time_;
+  history.last = time_;
+}
+
+template <unsigned K>
+typename LRUKReplacementPageCache<K>::LRUKReplacementPage *
+LRUKReplacementPageCache<K>::getVictim() const {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  for (const UnpinnedMap *unpinned : {&unpinned_, &interiorUnpinned_}) {
+    if (unpinned->empty()) {
+      continue;
+    }
+    for (auto &[key, page] : *unpinned) {
+      if (!isCorrelated(page->history)) {
+        return page;
+      }
+    }
+    return unpinned->begin()->second;
+  }
+  return nullptr;
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::retainHistory(unsigned pageId,
+                                                const History &history) {
+  if (retainedInformationPeriod_ == 0 || history.last == 0) {
+    return;
+  }
+
+  retained_[pageId] = history;
+  retainedByLast_[history.last] = pageId;
+  purgeHistory();
+}
+
+template <unsigned K> void LRUKReplacementPageCache<K>::purgeHistory() {
+  while (!retainedByLast_.empty() &&
+         time_ - retainedByLast_.begin()->first > retainedInformationPeriod_) {
+    retained_.erase(retainedByLast_.begin()->second);
+    retainedByLast_.erase(retainedByLast_.begin());
+  }
+}
+
+template <unsigned K>
+typename LRUKReplacementPageCache<K>::History
+LRUKReplacementPageCache<K>::takeHistory(unsigned pageId) {
+  auto retainedIterator = retained_.find(pageId);
+  if (retainedIterator == retained_.end()) {
+    return {};
+  }
+
+  History history = retainedIterator->second;
+  retainedByLast_.erase(history.last);
+  retained_.erase(retainedIterator);
+  return history;
+}
+
+template <unsigned K>
+void LRUKReplacementPageCache<K>::discardPage(LRUKReplacementPage *page) {
+  if (!page->pinned) {
+    getUnpinned(page).erase(getKey(page->history));
+  }
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+#endif // CS564_PROJECT_PAGE_CACHE_LRU_K_HPP
@@ -0,0 +1,291 @@
+#include "page_cache_midpoint_lru.hpp"
+
+MidpointLRUReplacementPageCache::MidpointLRUReplacementPage::
+    MidpointLRUReplacementPage(int argPageSize, int argExtraSize,
+                               unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      old(false), interior(false), hit(false), oldSinceFetch(0),
+      oldSinceEntry(0), prev(nullptr), next(nullptr) {}
+
+MidpointLRUReplacementPageCache::MidpointLRUReplacementPageCache(
+    int pageSize, int extraSize, double oldRatio,
+    unsigned long long oldBlockFetches, double oldBlockRatio)
+    : PageCache(pageSize, extraSize), head_(nullptr), tail_(nullptr),
+      midpoint_(nullptr), interiorHead_(nullptr), interiorTail_(nullptr),
+      numOld_(0), numOldEntries_(0), oldRatio_(oldRatio),
+      oldBlockFetches_(oldBlockFetches), oldBlockRatio_(oldBlockRatio) {}
+
+MidpointLRUReplacementPageCache::~MidpointLRUReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void MidpointLRUReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  MidpointLRUReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+  balance();
+}
+
+int MidpointLRUReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *MidpointLRUReplacementPageCache::fetchPage(unsigned pageId,
+                                                 bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. The
+  // page keeps its place in the list until it is unpinned. A page in the
+  // interior list returns to the list at the midpoint.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    MidpointLRUReplacementPage *page = pagesIterator->second;
+    if (page->interior) {
+      removeFromList(page);
+      insertAtMidpoint(page);
+    }
+    page->pinned = true;
+    page->hit = true;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  MidpointLRUReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new MidpointLRUReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+    page->hit = false;
+  }
+  pages_.emplace(pageId, page);
+  insertAtMidpoint(page);
+  return page;
+}
+
+void MidpointLRUReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (MidpointLRUReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. A young page moves to the head. An old page
+  // moves to the head only if it was fetched again after staying in the old
+  // sublist long enough. The fetch that loaded a page does not count.
+  page->pinned = false;
+  if (!page->old ||
+      (page->hit && numFetches_ - page->oldSinceFetch >= oldBlockFetches_ &&
+       numOldEntries_ - page->oldSinceEntry >= oldBlockRatio_ * numOld_)) {
+    moveToHead(page);
+  }
+  page->hit = false;
+
+  // SQLite has written the page by now, so classify it by its page-type byte.
+  if (isProtectedPage(page, page->pageId)) {
+    moveToInterior(page);
+  }
+}
+
+void MidpointLRUReplacementPageCache::changePageId(Page *pageBase,
+                                                   unsigned newPageId) {
+  auto *page = (MidpointLRUReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    MidpointLRUReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    removeFromList(oldPage);
+    delete oldPage;
+    balance();
+  }
+}
+
+void MidpointLRUReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    MidpointLRUReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromList(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+  balance();
+}
+
+void MidpointLRUReplacementPageCache::setOldRatio(double oldRatio) {
+  oldRatio_ = oldRatio;
+  balance();
+}
+
+void MidpointLRUReplacementPageCache::setOldBlockFetches(
+    unsigned long long oldBlockFetches) {
+  oldBlockFetches_ = oldBlockFetches;
+}
+
+void MidpointLRUReplacementPageCache::setOldBlockRatio(double oldBlockRatio) {
+  oldBlockRatio_ = oldBlockRatio;
+}
+
+void MidpointLRUReplacementPageCache::insertAtMidpoint(
+    MidpointLRUReplacementPage *page) {
+  MidpointLRUReplacementPage *next = midpoint_;
+  MidpointLRUReplacementPage *prev = next != nullptr ? next->prev : tail_;
+  page->prev = prev;
+  page->next = next;
+  if (prev != nullptr) {
+    prev->next = page;
+  } else {
+    head_ = page;
+  }
+  if (next != nullptr) {
+    next->prev = page;
+  } else {
+    tail_ = page;
+  }
+
+  page->old = true;
+  page->oldSinceFetch = numFetches_;
+  page->oldSinceEntry = ++numOldEntries_;
+  midpoint_ = page;
+  ++numOld_;
+  balance();
+}
+
+void MidpointLRUReplacementPageCache::moveToHead(
+    MidpointLRUReplacementPage *page) {
+  removeFromList(page);
+  page->prev = nullptr;
+  page->next = head_;
+  if (head_ != nullptr) {
+    head_->prev = page;
+  } else {
+    tail_ = page;
+  }
+  head_ = page;
+  balance();
+}
+
+void MidpointLRUReplacementPageCache::moveToInterior(
+    MidpointLRUReplacementPage *page) {
+  removeFromList(page);
+  page->interior = true;
+  page->prev = interiorTail_;
+  if (interiorTail_ != nullptr) {
+    interiorTail_->next = page;
+  } else {
+    interiorHead_ = page;
+  }
+  interiorTail_ = page;
+  balance();
+}
+
+void MidpointLRUReplacementPageCache::removeFromList(
+    MidpointLRUReplacementPage *page) {
+  MidpointLRUReplacementPage *&head = page->interior ? interiorHead_ : head_;
+  MidpointLRUReplacementPage *&tail = page->interior ? interiorTail_ : tail_;
+  page->interior = false;
+  if (page->old) {
+    if (midpoint_ == page) {
+      midpoint_ = page->next;
+    }
+    page->old = false;
+    --numOld_;
+  }
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+void MidpointLRUReplacementPageCache::balance() {
+  int target = (int)(oldRatio_ * getNumPages() + 0.5);
+
+  // Grow the old sublist by aging the oldest young pages.
+  while (numOld_ < target) {
+    MidpointLRUReplacementPage *page =
+        midpoint_ != nullptr ? midpoint_->prev : tail_;
+    if (page == nullptr) {
+      break;
+    }
+    page->old = true;
+    page->oldSinceFetch = numFetches_;
+    page->oldSinceEntry = ++numOldEntries_;
+    midpoint_ = page;
+    ++numOld_;
+  }
+
+  // Shrink the old sublist by making its newest pages young.
+  while (numOld_ > target) {
+    midpoint_->old = false;
+    midpoint_ = midpoint_->next;
+    --numOld_;
+  }
+}
+
+MidpointLRUReplacementPageCache::MidpointLRUReplacementPage *
+MidpointLRUReplacementPageCache::replacePage() {
+  MidpointLRUReplacementPage *page = tail_;
+  while (page != nullptr && page->pinned) {
+    page = page->prev;
+  }
+
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (page == nullptr) {
+    page = interiorHead_;
+  }
+  if (page != nullptr) {
+    removeFromList(page);
+    pages_.erase(page->pageId);
+  }
+  return page;
+}
+
+void MidpointLRUReplacementPageCache::discardPage(
+    MidpointLRUReplacementPage *page) {
+  removeFromList(page);
+  pages_.erase(page->pageId);
+  delete page;
+  balance();
+}
@@ -0,0 +1,173 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_MIDPOINT_LRU_HPP
+#define CS564_PROJECT_PAGE_CACHE_MIDPOINT_LRU_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+
+/**
+ * LRU page cache with midpoint insertion, in the style of the InnoDB buffer
+ * pool. The list is split into a young sublist at the head and an old sublist
+ * at the tail, which holds a configurable fraction of the pages. New pages
+ * enter at the midpoint, the head of the old sublist. A page in the old
+ * sublist moves to the head of the young sublist only if it is fetched again
+ * after staying in the old sublist for a minimum number of fetches, so a page
+ * that is only used by one scan never displaces young pages. Optionally, the
+ * page must also have moved a minimum fraction of the way down the old
+ * sublist. Pages in the young sublist move to its head whenever they are
+ * unpinned. Unpinned protected interior pages leave the list for a separate
+ * list and return at the midpoint when they are fetched again.
+ */
+class MidpointLRUReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct a MidpointLRUReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param oldRatio Fraction of the pages in the old sublist.
+   * @param oldBlockFetches Minimum number of fetches a page must stay in the
+   * old sublist before a hit moves it to the young sublist.
+   * @param oldBlockRatio Number of pages that must enter the old sublist after
+   * a page, as a fraction of the size of the old sublist, before a hit moves
+   * the page to the young sublist. Zero to disable.
+   */
+  MidpointLRUReplacementPageCache(int pageSize, int extraSize,
+                                  double oldRatio = 0.375,
+                                  unsigned long long oldBlockFetches = 10,
+                                  double oldBlockRatio = 0);
+
+  ~MidpointLRUReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Set the fraction of the pages in the old sublist. The midpoint moves
+   * immediately.
+   * @param oldRatio Fraction of the pages in the old sublist.
+   */
+  void setOldRatio(double oldRatio);
+
+  /**
+   * Set the minimum number of fetches a page must stay in the old sublist
+   * before a hit moves it to the young sublist.
+   * @param oldBlockFetches Number of fetches.
+   */
+  void setOldBlockFetches(unsigned long long oldBlockFetches);
+
+  /**
+   * Set the number of pages that must enter the old sublist after a page, as
+   * a fraction of the size of the old sublist, before a hit moves the page to
+   * the young sublist.
+   * @param oldBlockRatio Fraction of the size of the old sublist. Zero to
+   * disable.
+   */
+  void setOldBlockRatio(double oldBlockRatio);
+
+private:
+  struct MidpointLRUReplacementPage : public Page {
+    MidpointLRUReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+    bool old;
+
+    /** Whether the page is unpinned and in the interior list. */
+    bool interior;
+
+    /** Whether the page was fetched again since it was last unpinned. */
+    bool hit;
+
+    /** Value of `numFetches_` when the page entered the old sublist. */
+    unsigned long long oldSinceFetch;
+
+    /** Value of `numOldEntries_` when the page entered the old sublist. */
+    unsigned long long oldSinceEntry;
+
+    /**
+     * Neighbors in the list or the interior list. `prev` is toward the head.
+     */
+    MidpointLRUReplacementPage *prev;
+    MidpointLRUReplacementPage *next;
+  };
+
+  /**
+   * Insert a page at the midpoint, making it the newest page of the old
+   * sublist.
+   * @param page Pointer to a page not in the list.
+   */
+  void insertAtMidpoint(MidpointLRUReplacementPage *page);
+
+  /**
+   * Move a page to the head of the young sublist.
+   * @param page Pointer to a page in the list.
+   */
+  void moveToHead(MidpointLRUReplacementPage *page);
+
+  /**
+   * Move an unpinned protected interior page from the list to the tail of the
+   * interior list.
+   * @param page Pointer to a page in the list.
+   */
+  void moveToInterior(MidpointLRUReplacementPage *page);
+
+  /**
+   * Remove a page from the list or the interior list.
+   * @param page Pointer to a page in either list.
+   */
+  void removeFromList(MidpointLRUReplacementPage *page);
+
+  /**
+   * Move the midpoint until the old sublist holds its target number of pages.
+   */
+  void balance();
+
+  /**
+   * Choose a page to replace: the unpinned page nearest the tail. Protected
+   * interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page, removed from the list and `pages_`. Null if all
+   * pages are pinned.
+   */
+  MidpointLRUReplacementPage *replacePage();
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(MidpointLRUReplacementPage *page);
+
+  std::unordered_map<unsigned, MidpointLRUReplacementPage *> pages_;
+
+  /** Most recently used young page. */
+  MidpointLRUReplacementPage *head_;
+
+  /** Oldest page. Replaced first unless pinned. */
+  MidpointLRUReplacementPage *tail_;
+
+  /** Newest page of the old sublist. Null if the old sublist is empty. */
+  MidpointLRUReplacementPage *midpoint_;
+
+  /** Least and most recently unpinned protected interior pages. */
+  MidpointLRUReplacementPage *interiorHead_;
+  MidpointLRUReplacementPage *interiorTail_;
+
+  int numOld_;
+
+  /** Number of times a page has entered the old sublist. */
+  unsigned long long numOldEntries_;
+
+  double oldRatio_;
+  unsigned long long oldBlockFetches_;
+  double oldBlockRatio_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_MIDPOINT_LRU_HPP
@@ -0,0 +1,273 @@
+#include "page_cache_mq.hpp"
+
+#include <algorithm>
+
+MQReplacementPageCache::MQReplacementPage::MQReplacementPage(int argPageSize,
+                                                             int argExtraSize,
+                                                             unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      interior(false), frequency(0), expireTime(0), queue(0), prev(nullptr),
+      next(nullptr) {}
+
+void MQReplacementPageCache::PageList::pushBack(MQReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void MQReplacementPageCache::PageList::remove(MQReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+MQReplacementPageCache::MQReplacementPageCache(int pageSize, int extraSize,
+                                               int numQueues,
+                                               double lifeTimeRatio,
+                                               double outRatio)
+    : PageCache(pageSize, extraSize), queues_(std::max(1, numQueues)),
+      interiorQueues_(queues_.size()), time_(0), lifeTimeRatio_(lifeTimeRatio),
+      outRatio_(outRatio) {}
+
+MQReplacementPageCache::~MQReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void MQReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  MQReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+
+  // Shrink Qout to its new target size.
+  while ((int)out_.size() > getOutTarget()) {
+    outIndex_.erase(out_.back().first);
+    out_.pop_back();
+  }
+}
+
+int MQReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
+Page *MQReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+  ++time_;
+  adjust();
+
+  // If the page is already in the cache, pin it, record the fetch, and return
+  // the pointer.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    MQReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      getQueue(page).remove(page);
+      page->pinned = true;
+    }
+    accessPage(page);
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  MQReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new MQReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+    page->interior = false;
+  }
+  pages_.emplace(pageId, page);
+
+  // A page whose ID is in Qout resumes its count.
+  page->frequency = forgetOut(pageId);
+  accessPage(page);
+  return page;
+}
+
+void MQReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (MQReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. It becomes the most recently unpinned page of
+  // its queue. SQLite has written the page by now, so classify it by its
+  // page-type byte.
+  if (!page->pinned) {
+    getQueue(page).remove(page);
+  }
+  page->interior = isProtectedPage(page, page->pageId);
+  getQueue(page).pushBack(page);
+  page->pinned = false;
+}
+
+void MQReplacementPageCache::changePageId(Page *pageBase, unsigned newPageId) {
+  auto *page = (MQReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  forgetOut(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    MQReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    if (!oldPage->pinned) {
+      getQueue(oldPage).remove(oldPage);
+    }
+    delete oldPage;
+  }
+}
+
+void MQReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    MQReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (!page->pinned) {
+        getQueue(page).remove(page);
+      }
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so forget them in Qout as well.
+  for (auto outIterator = out_.begin(); outIterator != out_.end();) {
+    if (outIterator->first >= pageIdLimit) {
+      outIndex_.erase(outIterator->first);
+      outIterator = out_.erase(outIterator);
+    } else {
+      ++outIterator;
+    }
+  }
+}
+
+MQReplacementPageCache::PageList &
+MQReplacementPageCache::getQueue(MQReplacementPage *page) {
+  return (page->interior ? interiorQueues_ : queues_)[page->queue];
+}
+
+void MQReplacementPageCache::accessPage(MQReplacementPage *page) {
+  ++page->frequency;
+  page->queue = 0;
+  while (page->queue + 1 < (int)queues_.size() &&
+         (page->frequency >> (page->queue + 1)) != 0) {
+    ++page->queue;
+  }
+  page->expireTime = time_ + getLifeTime();
+}
+
+void MQReplacementPageCache::adjust() {
+  for (std::vector<PageList> *queues : {&queues_, &interiorQueues_}) {
+    for (int queue = 1; queue < (int)queues->size(); ++queue) {
+      MQReplacementPage *page = (*queues)[queue].head;
+      if (page != nullptr && page->expireTime < time_) {
+        (*queues)[queue].remove(page);
+        page->queue = queue - 1;
+        page->expireTime = time_ + getLifeTime();
+        (*queues)[queue - 1].pushBack(page);
+      }
+    }
+  }
+}
+
+MQReplacementPageCache::MQReplacementPage *
+MQReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  for (std::vector<PageList> *queues : {&queues_, &interiorQueues_}) {
+    for (PageList &queue : *queues) {
+      MQReplacementPage *page = queue.head;
+      if (page != nullptr) {
+        queue.remove(page);
+        pages_.erase(page->pageId);
+        rememberOut(page->pageId, page->frequency);
+        return page;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void MQReplacementPageCache::rememberOut(unsigned pageId, unsigned frequency) {
+  if (getOutTarget() == 0) {
+    return;
+  }
+
+  out_.emplace_front(pageId, frequency);
+  outIndex_[pageId] = out_.begin();
+  while ((int)out_.size() > getOutTarget()) {
+    outIndex_.erase(out_.back().first);
+    out_.pop_back();
+  }
+}
+
+unsigned MQReplacementPageCache::forgetOut(unsigned pageId) {
+  auto outIndexIterator = outIndex_.find(pageId);
+  if (outIndexIterator == outIndex_.end()) {
+    return 0;
+  }
+
+  unsigned frequency = outIndexIterator->second->second;
+  out_.erase(outIndexIterator->second);
+  outIndex_.erase(outIndexIterator);
+  return frequency;
+}
+
+void MQReplacementPageCache::discardPage(MQReplacementPage *page) {
+  if (!page->pinned) {
+    getQueue(page).remove(page);
+  }
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+unsigned long long MQReplacementPageCache::getLifeTime() const {
+  return (unsigned long long)std::max(1.0, lifeTimeRatio_ * maxNumPages_);
+}
+
+int MQReplacementPageCache::getOutTarget() const {
+  return std::max(0, (int)(outRatio_ * maxNumPages_));
+}
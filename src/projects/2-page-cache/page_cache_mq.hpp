@@ -0,0 +1,150 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_MQ_HPP
+#define CS564_PROJECT_PAGE_CACHE_MQ_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Multi-Queue (MQ) page cache as described by Zhou, Philbin, and Li. A page
+ * fetched `f` times belongs to LRU queue `floor(log2(f))`, capped at the last
+ * queue, and the victim is the least recently unpinned page in the lowest
+ * non-empty queue. Each fetch sets the page's expiration time to the current
+ * time plus the lifetime, and on every fetch an expired page at the front of a
+ * queue is demoted to the queue below. Replaced pages leave their page IDs and
+ * fetch counts in the history buffer Qout, so a returning page resumes its
+ * count. Time is measured in fetches.
+ */
+class MQReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct an MQReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param numQueues Number of LRU queues.
+   * @param lifeTimeRatio Lifetime of a page as a multiple of the maximum number
+   * of pages.
+   * @param outRatio Size of Qout as a multiple of the maximum number of pages.
+   */
+  MQReplacementPageCache(int pageSize, int extraSize, int numQueues = 8,
+                         double lifeTimeRatio = 2.0, double outRatio = 4.0);
+
+  ~MQReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct MQReplacementPage : public Page {
+    MQReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    unsigned frequency;
+    unsigned long long expireTime;
+    int queue;
+
+    /** Neighbors in the list of the page's queue. Null while pinned. */
+    MQReplacementPage *prev;
+    MQReplacementPage *next;
+  };
+
+  struct PageList {
+    MQReplacementPage *head = nullptr;
+    MQReplacementPage *tail = nullptr;
+
+    void pushBack(MQReplacementPage *page);
+    void remove(MQReplacementPage *page);
+  };
+
+  /**
+   * Get the list of unpinned pages of a page's queue.
+   * @param page Pointer to a page.
+   * @return List in `interiorQueues_` if the page is interior, in `queues_`
+   * otherwise.
+   */
+  PageList &getQueue(MQReplacementPage *page);
+
+  /**
+   * Record a fetch of a page: increment its count, move it to the queue for
+   * the count, and restart its lifetime.
+   * @param page Pointer to a pinned page.
+   */
+  void accessPage(MQReplacementPage *page);
+
+  /**
+   * Demote the front page of each queue above the lowest by one queue if its
+   * lifetime has expired. Queues of interior pages are demoted alike.
+   */
+  void adjust();
+
+  /**
+   * Choose a page to replace: the least recently unpinned page in the lowest
+   * non-empty queue. Its page ID and count are remembered in Qout. Protected
+   * interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page, removed from its queue and `pages_`. Null if
+   * all pages are pinned.
+   */
+  MQReplacementPage *replacePage();
+
+  /**
+   * Remember a replaced page ID and its count in Qout, dropping the oldest
+   * entries beyond its target size.
+   * @param pageId Page ID.
+   * @param frequency Number of fetches.
+   */
+  void rememberOut(unsigned pageId, unsigned frequency);
+
+  /**
+   * Forget a page ID in Qout, if present.
+   * @param pageId Page ID.
+   * @return Remembered number of fetches, or 0 if the page ID was not in Qout.
+   */
+  unsigned forgetOut(unsigned pageId);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(MQReplacementPage *page);
+
+  [[nodiscard]] unsigned long long getLifeTime() const;
+
+  [[nodiscard]] int getOutTarget() const;
+
+  std::unordered_map<unsigned, MQReplacementPage *> pages_;
+
+  /** LRU lists of unpinned pages in each queue. */
+  std::vector<PageList> queues_;
+
+  /** LRU lists of unpinned protected interior pages in each queue. */
+  std::vector<PageList> interiorQueues_;
+
+  /** Page IDs and counts of replaced pages, most recent first. */
+  std::list<std::pair<unsigned, unsigned>> out_;
+  std::unordered_map<unsigned,
+                     std::list<std::pair<unsigned, unsigned>>::iterator>
+      outIndex_;
+
+  unsigned long long time_;
+  double lifeTimeRatio_;
+  double outRatio_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_MQ_HPP
@@ -0,0 +1,261 @@
+#include "page_cache_optimal.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace {
+
+/** Next use of a page that is never fetched again. */
+constexpr std::size_t kNever = std::numeric_limits<std::size_t>::max();
+
+/** Maximum number of fetches in the trace skipped to resynchronise. */
+constexpr std::size_t kMaxSkippedFetches = 8;
+
+} // namespace
+
+std::vector<unsigned> OptimalReplacementPageCache::defaultTrace_;
+
+OptimalReplacementPageCache::OptimalReplacementPage::OptimalReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      interior(false), nextUse(kNever), version(0) {}
+
+OptimalReplacementPageCache::OptimalReplacementPageCache(int pageSize,
+                                                         int extraSize)
+    : PageCache(pageSize, extraSize), position_(0), numVersions_(0) {
+  setTrace(defaultTrace_);
+}
+
+OptimalReplacementPageCache::~OptimalReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void OptimalReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  OptimalReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+}
+
+int OptimalReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *OptimalReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+  std::size_t nextUse = advanceTrace(pageId);
+
+  // If the page is already in the cache, pin it and return the pointer. Its
+  // heap entry, if any, is now stale.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    OptimalReplacementPage *page = pagesIterator->second;
+    page->pinned = true;
+    page->nextUse = nextUse;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  OptimalReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new OptimalReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+  }
+  page->nextUse = nextUse;
+  pages_.emplace(pageId, page);
+  return page;
+}
+
+void OptimalReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (OptimalReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    pages_.erase(page->pageId);
+    delete page;
+    return;
+  }
+
+  // Otherwise, unpin the page and push a heap entry for it. SQLite has written
+  // the page by now, so classify it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+    page->interior = isProtectedPage(page, page->pageId);
+    pushHeap(page);
+  }
+}
+
+void OptimalReplacementPageCache::changePageId(Page *pageBase,
+                                               unsigned newPageId) {
+  auto *page = (OptimalReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID. The next use
+  // of the new page ID is unknown until it is fetched.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  page->nextUse = kNever;
+  if (!page->pinned) {
+    pushHeap(page);
+  }
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  // Its heap entries become stale because their versions do not match `page`.
+  if (!success) {
+    delete pagesIterator->second;
+    pagesIterator->second = page;
+  }
+}
+
+void OptimalReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  // Their heap entries become stale.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    if (pagesIterator->first >= pageIdLimit) {
+      delete pagesIterator->second;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+void OptimalReplacementPageCache::setTrace(const std::vector<unsigned> &trace) {
+  trace_ = trace;
+  position_ = 0;
+
+  // Scan the trace backward, remembering the next position of each page ID.
+  nextUses_.assign(trace_.size(), kNever);
+  positions_.clear();
+  std::unordered_map<unsigned, std::size_t> nextPositions;
+  for (std::size_t position = trace_.size(); position-- > 0;) {
+    auto [nextPositionsIterator, success] =
+        nextPositions.emplace(trace_[position], position);
+    if (!success) {
+      nextUses_[position] = nextPositionsIterator->second;
+      nextPositionsIterator->second = position;
+    }
+  }
+  for (std::size_t position = 0; position < trace_.size(); ++position) {
+    positions_[trace_[position]].push_back(position);
+  }
+
+  // The next uses of cached pages are unknown until they are fetched again.
+  for (auto &[pageId, page] : pages_) {
+    page->nextUse = kNever;
+  }
+  rebuildHeap();
+}
+
+void OptimalReplacementPageCache::setDefaultTrace(
+    const std::vector<unsigned> &trace) {
+  defaultTrace_ = trace;
+}
+
+std::size_t OptimalReplacementPageCache::advanceTrace(unsigned pageId) {
+  if (position_ < trace_.size() && trace_[position_] == pageId) {
+    return nextUses_[position_++];
+  }
+
+  // A repeat of the previous fetch, such as SQLite's retry of a fetch that
+  // returned a null pointer, does not advance the trace.
+  if (position_ > 0 && trace_[position_ - 1] == pageId) {
+    return nextUses_[position_ - 1];
+  }
+
+  // Find the next fetch of the page in the trace. If it is close, skip the
+  // fetches in between. Otherwise, the fetch is not in the trace, so stay at
+  // the same position.
+  auto positionsIterator = positions_.find(pageId);
+  if (positionsIterator == positions_.end()) {
+    return kNever;
+  }
+  const std::vector<std::size_t> &positions = positionsIterator->second;
+  auto nextPositionIterator =
+      std::lower_bound(positions.begin(), positions.end(), position_);
+  if (nextPositionIterator == positions.end()) {
+    return kNever;
+  }
+  std::size_t nextPosition = *nextPositionIterator;
+  if (nextPosition - position_ <= kMaxSkippedFetches) {
+    position_ = nextPosition + 1;
+    return nextUses_[nextPosition];
+  }
+  return nextPosition;
+}
+
+OptimalReplacementPageCache::OptimalReplacementPage *
+OptimalReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  for (Heap *heap : {&heap_, &interiorHeap_}) {
+    while (!heap->empty()) {
+      auto [nextUse, pageId, version] = heap->top();
+      heap->pop();
+
+      auto pagesIterator = pages_.find(pageId);
+      if (pagesIterator == pages_.end()) {
+        continue;
+      }
+      OptimalReplacementPage *page = pagesIterator->second;
+      if (page->pinned || page->version != version) {
+        continue;
+      }
+
+      pages_.erase(pagesIterator);
+      return page;
+    }
+  }
+  return nullptr;
+}
+
+void OptimalReplacementPageCache::pushHeap(OptimalReplacementPage *page) {
+  // Stale entries are only dropped when they reach the top, so rebuild the
+  // heaps once they outnumber the pages.
+  if (heap_.size() + interiorHeap_.size() > 2 * pages_.size() + 16) {
+    rebuildHeap();
+  }
+  page->version = ++numVersions_;
+  (page->interior ? interiorHeap_ : heap_)
+      .emplace(page->nextUse, page->pageId, page->version);
+}
+
+void OptimalReplacementPageCache::rebuildHeap() {
+  std::vector<HeapEntry> entries;
+  std::vector<HeapEntry> interiorEntries;
+  entries.reserve(pages_.size());
+  for (auto &[pageId, page] : pages_) {
+    if (!page->pinned) {
+      page->version = ++numVersions_;
+      (page->interior ? interiorEntries : entries)
+          .emplace_back(page->nextUse, pageId, page->version);
+    }
+  }
+  heap_ = Heap(std::less<HeapEntry>(), std::move(entries));
+  interiorHeap_ = Heap(std::less<HeapEntry>(), std::move(interiorEntries));
+}
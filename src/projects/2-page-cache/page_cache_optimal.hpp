@@ -0,0 +1,165 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_OPTIMAL_HPP
+#define CS564_PROJECT_PAGE_CACHE_OPTIMAL_HPP
+
+#include "page_cache.hpp"
+
+#include <cstddef>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Belady's optimal (OPT) page cache for offline trace replay. The page IDs of
+ * every call to `fetchPage` are supplied ahead of time with `setTrace`, and the
+ * unpinned page whose next fetch is farthest in the future is replaced. This
+ * gives an upper bound on the number of hits of any replacement policy for the
+ * trace.
+ *
+ * The next use of each position in the trace is precomputed. Unpinned pages
+ * are kept in a max-heap keyed by next use, and entries made stale by a later
+ * fetch, pin, or discard are skipped when they reach the top. Protected
+ * interior pages are kept in a heap of their own. A fetch that
+ * does not match the trace resynchronises the replay: a repeat of the previous
+ * fetch, such as SQLite's retry of a failed fetch, stays at the same position,
+ * and a page ID found a few positions ahead skips the fetches in between.
+ * Otherwise, the fetch is treated as an extra one that is not in the trace.
+ */
+class OptimalReplacementPageCache : public PageCache {
+public:
+  OptimalReplacementPageCache(int pageSize, int extraSize);
+
+  ~OptimalReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Set the page IDs of all future calls to `fetchPage`, in order, and restart
+   * replay from the first one.
+   * @param trace Page IDs.
+   */
+  void setTrace(const std::vector<unsigned> &trace);
+
+  /**
+   * Set the trace of every page cache constructed afterward. This is how a
+   * trace reaches a page cache constructed by `PageCacheMethods`.
+   * @param trace Page IDs.
+   */
+  static void setDefaultTrace(const std::vector<unsigned> &trace);
+
+private:
+  struct OptimalReplacementPage : public Page {
+    OptimalReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    /** Position in the trace of the next fetch of the page. */
+    std::size_t nextUse;
+
+    /** Version of the page's current heap entry. */
+    unsigned long long version;
+  };
+
+  /** Next use, page ID, and page version. */
+  using HeapEntry = std::tuple<std::size_t, unsigned, unsigned long long>;
+
+  using Heap = std::priority_queue<HeapEntry>;
+
+  /**
+   * Advance the trace past the current fetch, resynchronising if the fetch does
+   * not match the trace.
+   * @param pageId Page ID of the current fetch.
+   * @return Position in the trace of the next fetch of the page.
+   */
+  std::size_t advanceTrace(unsigned pageId);
+
+  /**
+   * Choose a page to replace: the unpinned page whose next use is farthest.
+   * Protected interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page, removed from `pages_`. Null if all pages are
+   * pinned.
+   */
+  OptimalReplacementPage *replacePage();
+
+  /**
+   * Push a heap entry for an unpinned page onto `interiorHeap_` if the page is
+   * interior, or onto `heap_` otherwise.
+   * @param page Pointer to a page.
+   */
+  void pushHeap(OptimalReplacementPage *page);
+
+  /**
+   * Rebuild the heaps from the unpinned pages, dropping stale entries.
+   */
+  void rebuildHeap();
+
+  std::unordered_map<unsigned, OptimalReplacementPage *> pages_;
+
+  Heap heap_;
+
+  /** Heap of unpinned protected interior pages. */
+  Heap interiorHeap_;
+
+  std::vector<unsigned> trace_;
+
+  /** Position in the trace of the next fetch of the page at each position. */
+  std::vector<std::size_t> nextUses_;
+
+  /** Positions in the trace of the fetches of each page ID, in order. */
+  std::unordered_map<unsigned, std::vector<std::size_t>> positions_;
+
+  /** Position in the trace of the current fetch. */
+  std::size_t position_;
+
+  /** Number of heap entry versions issued. Versions are unique. */
+  unsigned long long numVersions_;
+
+  /** Trace of page caches constructed afterward. */
+  static std::vector<unsigned> defaultTrace_;
+};
+
+/**
+ * Page cache that records the page ID of every call to `fetchPage` before
+ * forwarding it to `PageCacheImplementation`. Page caches constructed by
+ * `PageCacheMethods` are owned by SQLite, so all instances append to the same
+ * trace. Replay a workload under OPT by running it with
+ * `PageCacheMethods<TraceRecordingPageCache<T>>`, passing `getTrace()` to
+ * `OptimalReplacementPageCache::setDefaultTrace`, and running it again with
+ * `PageCacheMethods<OptimalReplacementPageCache>`.
+ */
+template <typename PageCacheImplementation>
+class TraceRecordingPageCache : public PageCacheImplementation {
+public:
+  TraceRecordingPageCache(int pageSize, int extraSize)
+      : PageCacheImplementation(pageSize, extraSize) {}
+
+  Page *fetchPage(unsigned pageId, bool allocate) override {
+    getTrace().push_back(pageId);
+    return PageCacheImplementation::fetchPage(pageId, allocate);
+  }
+
+  /**
+   * Get the page IDs of all calls to `fetchPage` so far, in order.
+   * @return Reference to the trace. Clear it to start a new recording.
+   */
+  static std::vector<unsigned> &getTrace() {
+    static std::vector<unsigned> trace;
+    return trace;
+  }
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_OPTIMAL_HPP
@@ -1,8 +1,9 @@
 #include "page_cache_random.hpp"
 
 RandomReplacementPageCache::RandomReplacementPage::RandomReplacementPage(
-    int argPageSize, int argExtraSize, unsigned argPageId, bool argPinned)
-    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(argPinned) {}
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), interior(false),
+      unpinnedIndex(-1) {}
 
 RandomReplacementPageCache::RandomReplacementPageCache(int pageSize,
                                                        int extraSize)
@@ -10,9 +11,7 @@ RandomReplacementPageCache::RandomReplacementPageCache(int pageSize,
 }
 
 RandomReplacementPageCache::~RandomReplacementPageCache() {
-  for (auto &[pageId, page] : pages_) {
-    free(page);
-  }
+  pages_.forEach([](RandomReplacementPage *page) { delete page; });
 }
 
 void RandomReplacementPageCache::setMaxNumPages(int maxNumPages) {
@@ -20,17 +19,12 @@ void RandomReplacementPageCache::setMaxNumPages(int maxNumPages) {
 
   // Discard unpinned pages until the number of pages in the cache is less than
   // or equal to `maxNumPages_` or only pinned pages remain.
-  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
-    if (getNumPages() <= maxNumPages_) {
+  for (int numPages = (int)pages_.size(); numPages > maxNumPages_; --numPages) {
+    RandomReplacementPage *page = getVictim();
+    if (page == nullptr) {
       break;
     }
-
-    if (!pagesIterator->second->pinned) {
-      delete pagesIterator->second;
-      pagesIterator = pages_.erase(pagesIterator);
-    } else {
-      ++pagesIterator;
-    }
+    discardPage(page);
   }
 }
 
@@ -42,11 +36,12 @@ Page *RandomReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
   ++numFetches_;
 
   // If the page is already in the cache, pin it and return the pointer.
-  auto pagesIterator = pages_.find(pageId);
-  if (pagesIterator != pages_.end()) {
+  if (RandomReplacementPage *page = pages_.find(pageId)) {
     ++numHits_;
-    pagesIterator->second->pinned = true;
-    return pagesIterator->second;
+    if (page->unpinnedIndex != -1) {
+      removeUnpinned(page);
+    }
+    return page;
   }
 
   // The page is not already in the cache. If parameter `allocate` is false,
@@ -58,49 +53,41 @@ Page *RandomReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
   // Parameter `allocate` is true. If the number of pages in the cache is less
   // than the maximum, allocate and return a pointer to a new page.
   if (getNumPages() < maxNumPages_) {
-    auto page = new RandomReplacementPage(pageSize_, extraSize_, pageId, true);
-    pages_.emplace(pageId, page);
+    auto page = new RandomReplacementPage(pageSize_, extraSize_, pageId);
+    pages_.insert(pageId, page);
     return page;
   }
 
   // The number of pages in the cache is greater than or equal to the maximum.
-  // Choose an existing unpinned page to replace. Initialize an iterator at a
-  // random page in `pages_`.
-  pagesIterator = pages_.begin();
-  std::advance(pagesIterator, std::uniform_int_distribution<int>(
-                                  0, (int)getNumPages() - 1)(randomGenerator_));
-
-  // Check each successive page in `pages_` to see if it is unpinned. If an
-  // unpinned page is found, pin it and return the pointer.
-  for (int iteration = 0; iteration < getNumPages(); ++iteration) {
-    if (!pagesIterator->second->pinned) {
-      // Replace the page ID in `pages_`.
-      RandomReplacementPage *page = pagesIterator->second;
-      pages_.erase(pagesIterator);
-      pages_.emplace(pageId, page);
-      return page;
-    }
-
-    // Advance the iterator, potentially wrapping around to the beginning.
-    if (++pagesIterator == pages_.end()) {
-      pagesIterator = pages_.begin();
-    }
+  // Replace an unpinned page chosen at random. If all pages are pinned, return
+  // a null pointer.
+  RandomReplacementPage *page = getVictim();
+  if (page == nullptr) {
+    return nullptr;
   }
 
-  // All pages are pinned. Return a null pointer.
-  return nullptr;
+  // Replace the page ID in `pages_`.
+  removeUnpinned(page);
+  pages_.erase(page->pageId);
+  page->pageId = pageId;
+  pages_.insert(pageId, page);
+  return page;
 }
 
 void RandomReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
   auto *page = (RandomReplacementPage *)pageBase;
 
   // If discard is true or the number of pages in the cache is greater than the
-  // maximum, discard the page. Otherwise, unpin the page.
+  // maximum, discard the page. Otherwise, unpin the page and classify it by its
+  // page-type byte.
   if (discard || getNumPages() > maxNumPages_) {
-    pages_.erase(page->pageId);
-    delete page;
+    discardPage(page);
   } else {
-    page->pinned = false;
+    if (page->unpinnedIndex != -1) {
+      removeUnpinned(page);
+    }
+    page->interior = isProtectedPage(page, page->pageId);
+    pushUnpinned(page);
   }
 }
 
@@ -112,24 +99,56 @@ void RandomReplacementPageCache::changePageId(Page *pageBase,
   pages_.erase(page->pageId);
   page->pageId = newPageId;
 
-  // Attempt to insert a page with page ID `newPageId` into `pages_`.
-  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
-
-  // If a page with page ID `newPageId` is already in the cache, discard it.
-  if (!success) {
-    delete pagesIterator->second;
-    pagesIterator->second = page;
+  // Insert the page with page ID `newPageId` into `pages_`. If a page with
+  // page ID `newPageId` is already in the cache, discard it.
+  RandomReplacementPage *oldPage = pages_.exchange(newPageId, page);
+  if (oldPage != nullptr) {
+    if (oldPage->unpinnedIndex != -1) {
+      removeUnpinned(oldPage);
+    }
+    delete oldPage;
   }
 }
 
 void RandomReplacementPageCache::discardPages(unsigned pageIdLimit) {
   // Discard all pages with page ID greater than or equal to `pageIdLimit`.
-  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
-    if (pagesIterator->second->pageId >= pageIdLimit) {
-      delete pagesIterator->second;
-      pagesIterator = pages_.erase(pagesIterator);
-    } else {
-      ++pagesIterator;
+  pages_.eraseFrom(pageIdLimit, [this](RandomReplacementPage *page) {
+    if (page->unpinnedIndex != -1) {
+      removeUnpinned(page);
     }
+    delete page;
+  });
+}
+
+void RandomReplacementPageCache::pushUnpinned(RandomReplacementPage *page) {
+  auto &unpinned = page->interior ? interiorUnpinned_ : unpinned_;
+  page->unpinnedIndex = (int)unpinned.size();
+  unpinned.push_back(page);
+}
+
+void RandomReplacementPageCache::removeUnpinned(RandomReplacementPage *page) {
+  auto &unpinned = page->interior ? interiorUnpinned_ : unpinned_;
+  RandomReplacementPage *last = unpinned.back();
+  unpinned[page->unpinnedIndex] = last;
+  last->unpinnedIndex = page->unpinnedIndex;
+  unpinned.pop_back();
+  page->unpinnedIndex = -1;
+}
+
+RandomReplacementPageCache::RandomReplacementPage *
+RandomReplacementPageCache::getVictim() {
+  auto &unpinned = unpinned_.empty() ? interiorUnpinned_ : unpinned_;
+  if (unpinned.empty()) {
+    return nullptr;
+  }
+  return unpinned[std::uniform_int_distribution<size_t>(
+      0, unpinned.size() - 1)(randomGenerator_)];
+}
+
+void RandomReplacementPageCache::discardPage(RandomReplacementPage *page) {
+  if (page->unpinnedIndex != -1) {
+    removeUnpinned(page);
   }
+  pages_.erase(page->pageId);
+  delete page;
 }
@@ -2,9 +2,10 @@
 #define CS564_PROJECT_PAGE_CACHE_RANDOM_HPP
 
 #include "page_cache.hpp"
+#include "page_index.hpp"
 
 #include <random>
-#include <unordered_map>
+#include <vector>
 
 class RandomReplacementPageCache : public PageCache {
 public:
@@ -26,14 +27,60 @@ public:
 
 private:
   struct RandomReplacementPage : public Page {
-    RandomReplacementPage(int pageSize, int extraSize, unsigned pageId,
-                          bool pinned);
+    RandomReplacementPage(int pageSize, int extraSize, unsigned pageId);
 
     unsigned pageId;
-    bool pinned;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Selects which array of unpinned pages it is in.
+     */
+    bool interior;
+
+    /** Position in its array of unpinned pages. -1 while pinned. */
+    int unpinnedIndex;
   };
 
-  std::unordered_map<unsigned, RandomReplacementPage *> pages_;
+  /**
+   * Append a page to its array of unpinned pages.
+   * @param page Pointer to a pinned page.
+   */
+  void pushUnpinned(RandomReplacementPage *page);
+
+  /**
+   * Remove a page from its array of unpinned pages by swapping the last page
+   * in the array into its position.
+   * @param page Pointer to an unpinned page.
+   */
+  void removeUnpinned(RandomReplacementPage *page);
+
+  /**
+   * Choose an unpinned page uniformly at random. Protected interior pages are
+   * only chosen when no other unpinned pages remain.
+   * @return Pointer to a page, or a null pointer if all pages are pinned.
+   */
+  RandomReplacementPage *getVictim();
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(RandomReplacementPage *page);
+
+  PageIndex<RandomReplacementPage> pages_;
+
+  /**
+   * Unpinned pages, in no particular order, so a page is removed or chosen at
+   * random in O(1).
+   */
+  std::vector<RandomReplacementPage *> unpinned_;
+
+  /**
+   * Unpinned protected interior pages. Empty unless interior pages are
+   * protected.
+   */
+  std::vector<RandomReplacementPage *> interiorUnpinned_;
+
   std::minstd_rand randomGenerator_;
 };
 
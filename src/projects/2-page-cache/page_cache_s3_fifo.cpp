@@ -0,0 +1,321 @@
+#include "page_cache_s3_fifo.hpp"
+
+#include <algorithm>
+
+S3FIFOReplacementPageCache::S3FIFOReplacementPage::S3FIFOReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId, Queue argQueue)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      queue(argQueue), interior(false), frequency(0), prev(nullptr),
+      next(nullptr) {}
+
+void S3FIFOReplacementPageCache::PageList::pushBack(
+    S3FIFOReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+  ++size;
+}
+
+void S3FIFOReplacementPageCache::PageList::remove(S3FIFOReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  --size;
+}
+
+S3FIFOReplacementPageCache::S3FIFOReplacementPageCache(int pageSize,
+                                                       int extraSize,
+                                                       double smallFraction)
+    : PageCache(pageSize, extraSize), numUnpinned_(0),
+      smallFraction_(smallFraction) {}
+
+S3FIFOReplacementPageCache::~S3FIFOReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void S3FIFOReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  S3FIFOReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+
+  // Shrink G to its new target size.
+  while ((int)ghost_.size() > getGhostTarget()) {
+    ghostIndex_.erase(ghost_.back());
+    ghost_.pop_back();
+  }
+}
+
+int S3FIFOReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *S3FIFOReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. The
+  // page keeps its place in its queue.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    S3FIFOReplacementPage *page = pagesIterator->second;
+    if (page->frequency < 3) {
+      ++page->frequency;
+    }
+    if (!page->pinned) {
+      page->pinned = true;
+      if (page->interior) {
+        getList(page).remove(page);
+        page->interior = false;
+        getList(page).pushBack(page);
+      } else {
+        --numUnpinned_;
+      }
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  S3FIFOReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new S3FIFOReplacementPage(pageSize_, extraSize_, pageId,
+                                     Queue::Small);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+    page->frequency = 0;
+  }
+  pages_.emplace(pageId, page);
+
+  // A page whose ID is in G was replaced from S recently, so it enters M.
+  // Other pages enter S.
+  page->queue = forgetGhost(pageId) ? Queue::Main : Queue::Small;
+  getList(page).pushBack(page);
+  return page;
+}
+
+void S3FIFOReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (S3FIFOReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. SQLite has written the page by now, so classify
+  // it by its page-type byte.
+  if (page->pinned) {
+    page->pinned = false;
+    if (isProtectedPage(page, page->pageId)) {
+      getList(page).remove(page);
+      page->interior = true;
+      getList(page).pushBack(page);
+    } else {
+      ++numUnpinned_;
+    }
+  }
+}
+
+void S3FIFOReplacementPageCache::changePageId(Page *pageBase,
+                                              unsigned newPageId) {
+  auto *page = (S3FIFOReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+  forgetGhost(newPageId);
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    S3FIFOReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    getList(oldPage).remove(oldPage);
+    numUnpinned_ -= !oldPage->pinned && !oldPage->interior;
+    delete oldPage;
+  }
+}
+
+void S3FIFOReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    S3FIFOReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      getList(page).remove(page);
+      numUnpinned_ -= !page->pinned && !page->interior;
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+
+  // The truncated page IDs no longer exist, so forget them in G as well.
+  for (auto ghostIterator = ghost_.begin(); ghostIterator != ghost_.end();) {
+    if (*ghostIterator >= pageIdLimit) {
+      ghostIndex_.erase(*ghostIterator);
+      ghostIterator = ghost_.erase(ghostIterator);
+    } else {
+      ++ghostIterator;
+    }
+  }
+}
+
+S3FIFOReplacementPageCache::S3FIFOReplacementPage *
+S3FIFOReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (numUnpinned_ == 0) {
+    PageList &interior =
+        interiorSmall_.head != nullptr ? interiorSmall_ : interiorMain_;
+    S3FIFOReplacementPage *page = interior.head;
+    if (page == nullptr) {
+      return nullptr;
+    }
+    interior.remove(page);
+    page->interior = false;
+    if (page->queue == Queue::Small) {
+      rememberGhost(page->pageId);
+    }
+    pages_.erase(page->pageId);
+    return page;
+  }
+
+  // Some unpinned page is replaceable, so this loop ends. Pages moved from S
+  // to M have frequency zero and are replaceable by the next `evictMain`.
+  S3FIFOReplacementPage *page = nullptr;
+  while (page == nullptr) {
+    if (small_.size + interiorSmall_.size >= getSmallTarget() ||
+        main_.size == 0) {
+      page = evictSmall();
+    }
+    if (page == nullptr) {
+      page = evictMain();
+    }
+    if (page == nullptr) {
+      page = evictSmall();
+    }
+  }
+
+  pages_.erase(page->pageId);
+  --numUnpinned_;
+  return page;
+}
+
+S3FIFOReplacementPageCache::S3FIFOReplacementPage *
+S3FIFOReplacementPageCache::evictSmall() {
+  for (int i = small_.size; i > 0; --i) {
+    S3FIFOReplacementPage *page = small_.head;
+    small_.remove(page);
+    if (page->pinned) {
+      small_.pushBack(page);
+    } else if (page->frequency > 1) {
+      page->queue = Queue::Main;
+      page->frequency = 0;
+      main_.pushBack(page);
+    } else {
+      rememberGhost(page->pageId);
+      return page;
+    }
+  }
+  return nullptr;
+}
+
+S3FIFOReplacementPageCache::S3FIFOReplacementPage *
+S3FIFOReplacementPageCache::evictMain() {
+  // Each page is examined at most four times, since frequencies are at most 3.
+  for (int i = 4 * main_.size; i > 0; --i) {
+    S3FIFOReplacementPage *page = main_.head;
+    main_.remove(page);
+    if (!page->pinned && page->frequency == 0) {
+      return page;
+    }
+    if (!page->pinned) {
+      --page->frequency;
+    }
+    main_.pushBack(page);
+  }
+  return nullptr;
+}
+
+void S3FIFOReplacementPageCache::rememberGhost(unsigned pageId) {
+  if (getGhostTarget() == 0) {
+    return;
+  }
+
+  ghost_.push_front(pageId);
+  ghostIndex_[pageId] = ghost_.begin();
+  while ((int)ghost_.size() > getGhostTarget()) {
+    ghostIndex_.erase(ghost_.back());
+    ghost_.pop_back();
+  }
+}
+
+bool S3FIFOReplacementPageCache::forgetGhost(unsigned pageId) {
+  auto ghostIndexIterator = ghostIndex_.find(pageId);
+  if (ghostIndexIterator == ghostIndex_.end()) {
+    return false;
+  }
+
+  ghost_.erase(ghostIndexIterator->second);
+  ghostIndex_.erase(ghostIndexIterator);
+  return true;
+}
+
+S3FIFOReplacementPageCache::PageList &
+S3FIFOReplacementPageCache::getList(S3FIFOReplacementPage *page) {
+  if (page->queue == Queue::Small) {
+    return page->interior ? interiorSmall_ : small_;
+  }
+  return page->interior ? interiorMain_ : main_;
+}
+
+void S3FIFOReplacementPageCache::discardPage(S3FIFOReplacementPage *page) {
+  getList(page).remove(page);
+  numUnpinned_ -= !page->pinned && !page->interior;
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+int S3FIFOReplacementPageCache::getSmallTarget() const {
+  return std::max(1, (int)(smallFraction_ * maxNumPages_));
+}
+
+int S3FIFOReplacementPageCache::getGhostTarget() const {
+  return std::max(0, maxNumPages_ - getSmallTarget());
+}
@@ -0,0 +1,155 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_S3_FIFO_HPP
+#define CS564_PROJECT_PAGE_CACHE_S3_FIFO_HPP
+
+#include "page_cache.hpp"
+
+#include <list>
+#include <unordered_map>
+
+/**
+ * S3-FIFO page cache as described by Yang et al. New pages enter a small FIFO
+ * queue S. Pages leaving S that were fetched again move to a main FIFO queue M,
+ * and the others leave their page IDs in a ghost FIFO queue G. A page fetched
+ * while its ID is in G enters M directly. Pages in M that were fetched since
+ * they were last examined are reinserted instead of replaced. A hit only
+ * increments a 2-bit frequency counter and never moves the page. Unpinned
+ * protected interior pages leave their queue for a separate list and return
+ * to the back of the queue when they are fetched again.
+ */
+class S3FIFOReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct an S3FIFOReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param smallFraction Size of S as a fraction of the maximum number of
+   * pages. G holds as many page IDs as M holds pages.
+   */
+  S3FIFOReplacementPageCache(int pageSize, int extraSize,
+                             double smallFraction = 0.1);
+
+  ~S3FIFOReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  enum class Queue { Small, Main };
+
+  struct S3FIFOReplacementPage : public Page {
+    S3FIFOReplacementPage(int pageSize, int extraSize, unsigned pageId,
+                          Queue queue);
+
+    unsigned pageId;
+    bool pinned;
+    Queue queue;
+
+    /** Whether the page is unpinned and in an interior list. */
+    bool interior;
+
+    /** Saturating 2-bit frequency counter. */
+    unsigned char frequency;
+
+    /** Neighbors in the FIFO or the interior list of the page's queue. */
+    S3FIFOReplacementPage *prev;
+    S3FIFOReplacementPage *next;
+  };
+
+  struct PageList {
+    S3FIFOReplacementPage *head = nullptr;
+    S3FIFOReplacementPage *tail = nullptr;
+    int size = 0;
+
+    void pushBack(S3FIFOReplacementPage *page);
+    void remove(S3FIFOReplacementPage *page);
+  };
+
+  /**
+   * Choose a page to replace. S is examined first if it is at or over its
+   * target size, and M otherwise. Protected interior pages are only chosen if
+   * no other page is unpinned, those from S first.
+   * @return Pointer to a page, removed from its queue and `pages_`. Null if
+   * all pages are pinned.
+   */
+  S3FIFOReplacementPage *replacePage();
+
+  /**
+   * Examine each page in S once, oldest first. Pinned pages go to the back of
+   * S, and pages fetched again move to M. The first other page is replaced
+   * and its page ID is remembered in G.
+   * @return Pointer to a page, removed from S. Null if no page in S can be
+   * replaced.
+   */
+  S3FIFOReplacementPage *evictSmall();
+
+  /**
+   * Examine pages in M, oldest first. Pinned pages and pages whose frequency
+   * is positive go to the back of M, the latter with their frequency
+   * decremented. The first other page is replaced.
+   * @return Pointer to a page, removed from M. Null if no page in M can be
+   * replaced.
+   */
+  S3FIFOReplacementPage *evictMain();
+
+  /**
+   * Remember a replaced page ID in G, dropping the oldest IDs beyond its
+   * target size.
+   * @param pageId Page ID.
+   */
+  void rememberGhost(unsigned pageId);
+
+  /**
+   * Forget a page ID in G, if present.
+   * @param pageId Page ID.
+   * @return True if the page ID was in G.
+   */
+  bool forgetGhost(unsigned pageId);
+
+  /**
+   * Get the list that holds a page.
+   * @param page Pointer to a page.
+   * @return The interior list of the page's queue if the page is interior, or
+   * the FIFO of its queue otherwise.
+   */
+  [[nodiscard]] PageList &getList(S3FIFOReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(S3FIFOReplacementPage *page);
+
+  [[nodiscard]] int getSmallTarget() const;
+
+  [[nodiscard]] int getGhostTarget() const;
+
+  std::unordered_map<unsigned, S3FIFOReplacementPage *> pages_;
+
+  /** FIFO queues of pages, pinned or not. The head is the oldest. */
+  PageList small_;
+  PageList main_;
+
+  /** Unpinned protected interior pages of S and M, oldest first. */
+  PageList interiorSmall_;
+  PageList interiorMain_;
+
+  /** Page IDs replaced from S, most recent first. */
+  std::list<unsigned> ghost_;
+  std::unordered_map<unsigned, std::list<unsigned>::iterator> ghostIndex_;
+
+  /** Number of unpinned pages in `small_` and `main_`. */
+  int numUnpinned_;
+
+  double smallFraction_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_S3_FIFO_HPP
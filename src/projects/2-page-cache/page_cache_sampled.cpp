@@ -0,0 +1,217 @@
+#include "page_cache_sampled.hpp"
+
+#include <algorithm>
+#include <utility>
+
+double SampledReplacementPageCache::scoreUnpinTime(const PageStats &stats,
+                                                   std::uint32_t time) {
+  return -(double)(std::uint32_t)(time - stats.unpinTime);
+}
+
+double SampledReplacementPageCache::scoreFrequency(const PageStats &stats,
+                                                   std::uint32_t) {
+  return (double)stats.numFetches;
+}
+
+double SampledReplacementPageCache::scoreHyperbolic(const PageStats &stats,
+                                                    std::uint32_t time) {
+  return (double)stats.numFetches /
+         ((double)(std::uint32_t)(time - stats.insertTime) + 1.0);
+}
+
+SampledReplacementPageCache::SampledReplacementPage::SampledReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), interior(false),
+      unpinnedIndex(-1), stats{0, 0, 0} {}
+
+SampledReplacementPageCache::SampledReplacementPageCache(int pageSize,
+                                                         int extraSize,
+                                                         int sampleSize,
+                                                         Scorer scorer)
+    : PageCache(pageSize, extraSize), randomGenerator_(std::random_device()()),
+      sampleSize_(sampleSize), scorer_(std::move(scorer)) {}
+
+SampledReplacementPageCache::~SampledReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void SampledReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  SampledReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+}
+
+int SampledReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *SampledReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    SampledReplacementPage *page = pagesIterator->second;
+    if (page->unpinnedIndex != -1) {
+      removeUnpinned(page);
+    }
+    ++page->stats.numFetches;
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  SampledReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new SampledReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+  }
+  auto time = (std::uint32_t)numFetches_;
+  page->stats = {time, time, 1};
+  pages_.emplace(pageId, page);
+  return page;
+}
+
+void SampledReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (SampledReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page and classify it by its page-type byte.
+  page->stats.unpinTime = (std::uint32_t)numFetches_;
+  if (page->unpinnedIndex != -1) {
+    removeUnpinned(page);
+  }
+  page->interior = isProtectedPage(page, page->pageId);
+  pushUnpinned(page);
+}
+
+void SampledReplacementPageCache::changePageId(Page *pageBase,
+                                               unsigned newPageId) {
+  auto *page = (SampledReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    SampledReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    if (oldPage->unpinnedIndex != -1) {
+      removeUnpinned(oldPage);
+    }
+    delete oldPage;
+  }
+}
+
+void SampledReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    SampledReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      if (page->unpinnedIndex != -1) {
+        removeUnpinned(page);
+      }
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+void SampledReplacementPageCache::setSampleSize(int sampleSize) {
+  sampleSize_ = sampleSize;
+}
+
+void SampledReplacementPageCache::setScorer(Scorer scorer) {
+  scorer_ = std::move(scorer);
+}
+
+SampledReplacementPageCache::SampledReplacementPage *
+SampledReplacementPageCache::replacePage() {
+  auto &unpinned = unpinned_.empty() ? interiorUnpinned_ : unpinned_;
+  if (unpinned.empty()) {
+    return nullptr;
+  }
+
+  // Score each candidate, keeping the lowest. If there are no more unpinned
+  // pages than candidates, every unpinned page is a candidate, and they are
+  // scored starting at a random one so that ties are not always broken in
+  // favor of the same position.
+  int numUnpinned = (int)unpinned.size();
+  bool sample = sampleSize_ < numUnpinned;
+  int numCandidates = sample ? std::max(1, sampleSize_) : numUnpinned;
+  std::uniform_int_distribution<int> distribution(0, numUnpinned - 1);
+  int start = sample ? 0 : distribution(randomGenerator_);
+
+  auto time = (std::uint32_t)numFetches_;
+  SampledReplacementPage *victim = nullptr;
+  double victimScore = 0.0;
+  for (int i = 0; i < numCandidates; ++i) {
+    SampledReplacementPage *page =
+        unpinned[sample ? distribution(randomGenerator_)
+                        : (start + i) % numUnpinned];
+    double score = scorer_(page->stats, time);
+    if (victim == nullptr || score < victimScore) {
+      victim = page;
+      victimScore = score;
+    }
+  }
+
+  removeUnpinned(victim);
+  pages_.erase(victim->pageId);
+  return victim;
+}
+
+void SampledReplacementPageCache::pushUnpinned(SampledReplacementPage *page) {
+  auto &unpinned = page->interior ? interiorUnpinned_ : unpinned_;
+  page->unpinnedIndex = (int)unpinned.size();
+  unpinned.push_back(page);
+}
+
+void SampledReplacementPageCache::removeUnpinned(SampledReplacementPage *page) {
+  auto &unpinned = page->interior ? interiorUnpinned_ : unpinned_;
+  SampledReplacementPage *last = unpinned.back();
+  unpinned[page->unpinnedIndex] = last;
+  last->unpinnedIndex = page->unpinnedIndex;
+  unpinned.pop_back();
+  page->unpinnedIndex = -1;
+}
+
+void SampledReplacementPageCache::discardPage(SampledReplacementPage *page) {
+  if (page->unpinnedIndex != -1) {
+    removeUnpinned(page);
+  }
+  pages_.erase(page->pageId);
+  delete page;
+}
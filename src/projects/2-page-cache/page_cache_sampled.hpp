@@ -0,0 +1,149 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_SAMPLED_HPP
+#define CS564_PROJECT_PAGE_CACHE_SAMPLED_HPP
+
+#include "page_cache.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Sampled page cache, a generalization of random replacement. To replace a
+ * page, a fixed number of unpinned pages are drawn at random and the one with
+ * the lowest score is replaced. The score is computed by a pluggable scorer
+ * from a few counters kept per page, so the cache approximates LRU, LFU, or
+ * hyperbolic caching without per-page list pointers. Unpinned pages are kept in
+ * a dense array, so drawing a candidate is O(1). When there are no more
+ * unpinned pages than candidates, every unpinned page is scored, starting at a
+ * random one so that ties are broken at random. A constant scorer therefore
+ * gives random replacement.
+ */
+class SampledReplacementPageCache : public PageCache {
+public:
+  /**
+   * Counters kept for each page. Times are measured in fetches on a 32-bit
+   * clock that wraps around, so scorers should only use differences of times.
+   */
+  struct PageStats {
+    /** Time the page entered the cache. */
+    std::uint32_t insertTime;
+
+    /** Time the page was last unpinned. */
+    std::uint32_t unpinTime;
+
+    /** Number of fetches of the page since it entered the cache. */
+    std::uint32_t numFetches;
+  };
+
+  /**
+   * Function that scores a candidate. The candidate with the lowest score is
+   * replaced.
+   * @param stats Counters of the candidate.
+   * @param time Current time.
+   * @return Score.
+   */
+  using Scorer =
+      std::function<double(const PageStats &stats, std::uint32_t time)>;
+
+  /** Scores by time since last unpin, approximating LRU. */
+  static double scoreUnpinTime(const PageStats &stats, std::uint32_t time);
+
+  /** Scores by number of fetches, approximating LFU. */
+  static double scoreFrequency(const PageStats &stats, std::uint32_t time);
+
+  /** Scores by number of fetches per unit of time in the cache. */
+  static double scoreHyperbolic(const PageStats &stats, std::uint32_t time);
+
+  /**
+   * Construct a SampledReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param sampleSize Number of candidates drawn per replacement.
+   * @param scorer Function that scores candidates.
+   */
+  SampledReplacementPageCache(int pageSize, int extraSize, int sampleSize = 5,
+                              Scorer scorer = scoreUnpinTime);
+
+  ~SampledReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Set the number of candidates drawn per replacement.
+   * @param sampleSize Number of candidates.
+   */
+  void setSampleSize(int sampleSize);
+
+  /**
+   * Set the function that scores candidates.
+   * @param scorer Function that scores candidates.
+   */
+  void setScorer(Scorer scorer);
+
+private:
+  struct SampledReplacementPage : public Page {
+    SampledReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+
+    /**
+     * Whether the page was classified as a protected interior page when it was
+     * last unpinned. Selects which array of unpinned pages it is in.
+     */
+    bool interior;
+
+    /** Position in its array of unpinned pages. -1 while pinned. */
+    int unpinnedIndex;
+
+    PageStats stats;
+  };
+
+  /**
+   * Choose a page to replace: the lowest scoring of `sampleSize_` unpinned
+   * pages drawn at random, or of all unpinned pages if there are no more than
+   * that. Ties go to the candidate scored first. Protected interior pages are
+   * only drawn when no other unpinned pages remain.
+   * @return Pointer to a page, removed from `unpinned_` and `pages_`. Null if
+   * all pages are pinned.
+   */
+  SampledReplacementPage *replacePage();
+
+  void pushUnpinned(SampledReplacementPage *page);
+
+  void removeUnpinned(SampledReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(SampledReplacementPage *page);
+
+  std::unordered_map<unsigned, SampledReplacementPage *> pages_;
+
+  /** Unpinned pages, in no particular order. */
+  std::vector<SampledReplacementPage *> unpinned_;
+
+  /**
+   * Unpinned protected interior pages. Empty unless interior pages are
+   * protected.
+   */
+  std::vector<SampledReplacementPage *> interiorUnpinned_;
+
+  std::minstd_rand randomGenerator_;
+  int sampleSize_;
+  Scorer scorer_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_SAMPLED_HPP
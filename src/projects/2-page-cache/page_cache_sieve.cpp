@@ -0,0 +1,218 @@
+#include "page_cache_sieve.hpp"
+
+SieveReplacementPageCache::SieveReplacementPage::SieveReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      visited(false), interior(false), prev(nullptr), next(nullptr) {}
+
+SieveReplacementPageCache::SieveReplacementPageCache(int pageSize,
+                                                     int extraSize)
+    : PageCache(pageSize, extraSize), head_(nullptr), tail_(nullptr),
+      hand_(nullptr), interiorHead_(nullptr), interiorTail_(nullptr),
+      numUnpinned_(0) {}
+
+SieveReplacementPageCache::~SieveReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void SieveReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  SieveReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+}
+
+int SieveReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *SieveReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it, mark it visited, and return
+  // the pointer. The page keeps its place in the queue. A page in the interior
+  // list returns to the head.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    SieveReplacementPage *page = pagesIterator->second;
+    page->visited = true;
+    if (!page->pinned) {
+      page->pinned = true;
+      if (page->interior) {
+        removeFromQueue(page);
+        pushHead(page);
+      } else {
+        --numUnpinned_;
+      }
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  SieveReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new SieveReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+    page->visited = false;
+  }
+  pages_.emplace(pageId, page);
+  pushHead(page);
+  return page;
+}
+
+void SieveReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (SieveReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. SQLite has written the page by now, so classify
+  // it by its page-type byte.
+  if (page->pinned) {
+    if (isProtectedPage(page, page->pageId)) {
+      moveToInterior(page);
+    } else {
+      ++numUnpinned_;
+    }
+    page->pinned = false;
+  }
+}
+
+void SieveReplacementPageCache::changePageId(Page *pageBase,
+                                             unsigned newPageId) {
+  auto *page = (SieveReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    SieveReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    removeFromQueue(oldPage);
+    delete oldPage;
+  }
+}
+
+void SieveReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    SieveReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromQueue(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+SieveReplacementPageCache::SieveReplacementPage *
+SieveReplacementPageCache::replacePage() {
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (numUnpinned_ == 0) {
+    SieveReplacementPage *page = interiorHead_;
+    if (page != nullptr) {
+      removeFromQueue(page);
+      pages_.erase(page->pageId);
+    }
+    return page;
+  }
+
+  // Some page is unpinned, so the hand stops within two passes. Pinned pages
+  // keep their visited bits, so the hit that pinned a page still counts once
+  // it is unpinned.
+  SieveReplacementPage *page = hand_ != nullptr ? hand_ : tail_;
+  while (page->visited || page->pinned) {
+    if (!page->pinned) {
+      page->visited = false;
+    }
+    page = page->prev != nullptr ? page->prev : tail_;
+  }
+
+  hand_ = page;
+  removeFromQueue(page);
+  pages_.erase(page->pageId);
+  return page;
+}
+
+void SieveReplacementPageCache::pushHead(SieveReplacementPage *page) {
+  page->prev = nullptr;
+  page->next = head_;
+  if (head_ != nullptr) {
+    head_->prev = page;
+  } else {
+    tail_ = page;
+  }
+  head_ = page;
+}
+
+void SieveReplacementPageCache::moveToInterior(SieveReplacementPage *page) {
+  removeFromQueue(page);
+  page->interior = true;
+  page->prev = interiorTail_;
+  if (interiorTail_ != nullptr) {
+    interiorTail_->next = page;
+  } else {
+    interiorHead_ = page;
+  }
+  interiorTail_ = page;
+}
+
+void SieveReplacementPageCache::removeFromQueue(SieveReplacementPage *page) {
+  SieveReplacementPage *&head = page->interior ? interiorHead_ : head_;
+  SieveReplacementPage *&tail = page->interior ? interiorTail_ : tail_;
+  if (hand_ == page) {
+    hand_ = page->prev;
+  }
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+  numUnpinned_ -= !page->pinned && !page->interior;
+  page->interior = false;
+}
+
+void SieveReplacementPageCache::discardPage(SieveReplacementPage *page) {
+  removeFromQueue(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
@@ -0,0 +1,106 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_SIEVE_HPP
+#define CS564_PROJECT_PAGE_CACHE_SIEVE_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+
+/**
+ * SIEVE page cache as described by Zhang et al. Pages are kept in a single FIFO
+ * queue, newest at the head. A hit only sets the page's visited bit. The hand
+ * moves from the tail toward the head, clearing the visited bits of unpinned
+ * pages and skipping pinned pages, and replaces the first unvisited unpinned
+ * page. Visited pages keep their place in the queue. Unpinned protected
+ * interior pages leave the queue for a separate list and return at the head
+ * when they are fetched again.
+ */
+class SieveReplacementPageCache : public PageCache {
+public:
+  SieveReplacementPageCache(int pageSize, int extraSize);
+
+  ~SieveReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct SieveReplacementPage : public Page {
+    SieveReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+    bool visited;
+
+    /** Whether the page is unpinned and in the interior list. */
+    bool interior;
+
+    /**
+     * Neighbors in the queue or the interior list. `prev` is toward the head.
+     */
+    SieveReplacementPage *prev;
+    SieveReplacementPage *next;
+  };
+
+  /**
+   * Choose a page to replace by moving the hand toward the head. Protected
+   * interior pages are only chosen if no other page is unpinned.
+   * @return Pointer to a page, removed from the queue and `pages_`. Null if
+   * all pages are pinned.
+   */
+  SieveReplacementPage *replacePage();
+
+  /**
+   * Insert a page at the head of the queue.
+   * @param page Pointer to a page.
+   */
+  void pushHead(SieveReplacementPage *page);
+
+  /**
+   * Move a protected interior page that is being unpinned from the queue to
+   * the tail of the interior list.
+   * @param page Pointer to a pinned page in the queue.
+   */
+  void moveToInterior(SieveReplacementPage *page);
+
+  /**
+   * Remove a page from the queue, moving the hand off it if necessary, or from
+   * the interior list.
+   * @param page Pointer to a page.
+   */
+  void removeFromQueue(SieveReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(SieveReplacementPage *page);
+
+  std::unordered_map<unsigned, SieveReplacementPage *> pages_;
+
+  /** Newest page. */
+  SieveReplacementPage *head_;
+
+  /** Oldest page. */
+  SieveReplacementPage *tail_;
+
+  /** Next page to examine. Null means the tail. */
+  SieveReplacementPage *hand_;
+
+  /** Least and most recently unpinned protected interior pages. */
+  SieveReplacementPage *interiorHead_;
+  SieveReplacementPage *interiorTail_;
+
+  /** Number of unpinned pages in the queue. */
+  int numUnpinned_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_SIEVE_HPP
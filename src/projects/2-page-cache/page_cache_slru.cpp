@@ -0,0 +1,220 @@
+#include "page_cache_slru.hpp"
+
+SLRUReplacementPageCache::SLRUReplacementPage::SLRUReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      isProtected(false), interior(false), prev(nullptr), next(nullptr) {}
+
+void SLRUReplacementPageCache::PageList::pushBack(SLRUReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void SLRUReplacementPageCache::PageList::remove(SLRUReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+SLRUReplacementPageCache::SLRUReplacementPageCache(int pageSize, int extraSize,
+                                                   double protectedFraction)
+    : PageCache(pageSize, extraSize), protectedSize_(0),
+      protectedFraction_(protectedFraction) {}
+
+SLRUReplacementPageCache::~SLRUReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void SLRUReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  SLRUReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+  trimProtected();
+}
+
+int SLRUReplacementPageCache::getNumPages() const { return (int)pages_.size(); }
+
+Page *SLRUReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. A page
+  // in probation moves to the protected segment.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    SLRUReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      getList(page).remove(page);
+      page->pinned = true;
+    }
+    if (!page->isProtected) {
+      page->isProtected = true;
+      ++protectedSize_;
+      trimProtected();
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer.
+  if (!allocate) {
+    return nullptr;
+  }
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  SLRUReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new SLRUReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+  }
+  pages_.emplace(pageId, page);
+  return page;
+}
+
+void SLRUReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (SLRUReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. It becomes the most recently unpinned page of
+  // its segment. Protected pages that were pinned when the segment overflowed
+  // are demoted now. SQLite has written the page by now, so classify it by its
+  // page-type byte.
+  if (!page->pinned) {
+    getList(page).remove(page);
+  }
+  page->interior = isProtectedPage(page, page->pageId);
+  getList(page).pushBack(page);
+  page->pinned = false;
+  trimProtected();
+}
+
+void SLRUReplacementPageCache::changePageId(Page *pageBase,
+                                            unsigned newPageId) {
+  auto *page = (SLRUReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    SLRUReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    removeFromSegment(oldPage);
+    delete oldPage;
+  }
+}
+
+void SLRUReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    SLRUReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromSegment(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+SLRUReplacementPageCache::PageList &
+SLRUReplacementPageCache::getList(SLRUReplacementPage *page) {
+  if (page->isProtected) {
+    return page->interior ? interiorProtected_ : protected_;
+  }
+  return page->interior ? interiorProbation_ : probation_;
+}
+
+void SLRUReplacementPageCache::trimProtected() {
+  while (protectedSize_ > getProtectedTarget()) {
+    SLRUReplacementPage *page = protected_.head != nullptr
+                                    ? protected_.head
+                                    : interiorProtected_.head;
+    if (page == nullptr) {
+      break;
+    }
+    getList(page).remove(page);
+    page->isProtected = false;
+    --protectedSize_;
+    getList(page).pushBack(page);
+  }
+}
+
+SLRUReplacementPageCache::SLRUReplacementPage *
+SLRUReplacementPageCache::replacePage() {
+  SLRUReplacementPage *page =
+      probation_.head != nullptr ? probation_.head : protected_.head;
+
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (page == nullptr) {
+    page = interiorProbation_.head != nullptr ? interiorProbation_.head
+                                              : interiorProtected_.head;
+  }
+  if (page == nullptr) {
+    return nullptr;
+  }
+
+  removeFromSegment(page);
+  pages_.erase(page->pageId);
+  page->isProtected = false;
+  page->interior = false;
+  return page;
+}
+
+void SLRUReplacementPageCache::removeFromSegment(SLRUReplacementPage *page) {
+  if (!page->pinned) {
+    getList(page).remove(page);
+  }
+  protectedSize_ -= page->isProtected;
+}
+
+void SLRUReplacementPageCache::discardPage(SLRUReplacementPage *page) {
+  removeFromSegment(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+int SLRUReplacementPageCache::getProtectedTarget() const {
+  return (int)(protectedFraction_ * maxNumPages_);
+}
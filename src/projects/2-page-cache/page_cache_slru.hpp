@@ -0,0 +1,120 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_SLRU_HPP
+#define CS564_PROJECT_PAGE_CACHE_SLRU_HPP
+
+#include "page_cache.hpp"
+
+#include <unordered_map>
+
+/**
+ * Segmented LRU (SLRU) page cache. New pages enter the probationary segment. A
+ * page fetched again while in probation moves to the protected segment. When
+ * the protected segment is over its target size, its least recently unpinned
+ * pages are demoted to the most recently unpinned end of probation. Victims
+ * are taken from probation first. Both segments are LRU lists ordered by unpin
+ * time.
+ */
+class SLRUReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct an SLRUReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param protectedFraction Size of the protected segment as a fraction of the
+   * maximum number of pages.
+   */
+  SLRUReplacementPageCache(int pageSize, int extraSize,
+                           double protectedFraction = 0.8);
+
+  ~SLRUReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+private:
+  struct SLRUReplacementPage : public Page {
+    SLRUReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+    bool isProtected;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    /** Neighbors in the list of the page's segment. Null while pinned. */
+    SLRUReplacementPage *prev;
+    SLRUReplacementPage *next;
+  };
+
+  struct PageList {
+    SLRUReplacementPage *head = nullptr;
+    SLRUReplacementPage *tail = nullptr;
+
+    void pushBack(SLRUReplacementPage *page);
+    void remove(SLRUReplacementPage *page);
+  };
+
+  /**
+   * Get the list of unpinned pages of a page's segment.
+   * @param page Pointer to a page.
+   * @return The interior list of the segment if the page is interior, or the
+   * LRU list of the segment otherwise.
+   */
+  PageList &getList(SLRUReplacementPage *page);
+
+  /**
+   * Demote least recently unpinned protected pages to probation while the
+   * protected segment is over its target size, interior pages last.
+   */
+  void trimProtected();
+
+  /**
+   * Choose a page to replace: the least recently unpinned page in probation,
+   * or in the protected segment if probation has no unpinned pages. B-tree
+   * interior pages flagged by `isProtectedPage` are only chosen if no other
+   * page is unpinned.
+   * @return Pointer to a page, removed from its segment and `pages_`. Null if
+   * all pages are pinned.
+   */
+  SLRUReplacementPage *replacePage();
+
+  /**
+   * Remove a page from the list and size of its segment.
+   * @param page Pointer to a page.
+   */
+  void removeFromSegment(SLRUReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(SLRUReplacementPage *page);
+
+  [[nodiscard]] int getProtectedTarget() const;
+
+  std::unordered_map<unsigned, SLRUReplacementPage *> pages_;
+
+  /** LRU lists of unpinned pages in each segment. */
+  PageList probation_;
+  PageList protected_;
+
+  /** LRU lists of unpinned protected interior pages in each segment. */
+  PageList interiorProbation_;
+  PageList interiorProtected_;
+
+  /** Number of pages in the protected segment, pinned or not. */
+  int protectedSize_;
+
+  double protectedFraction_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_SLRU_HPP
@@ -0,0 +1,428 @@
+#include "page_cache_w_tinylfu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/** Hill climber step as a fraction of the maximum number of pages. */
+constexpr double kStepFraction = 0.0625;
+
+/** Factor applied to the step after each sample. */
+constexpr double kStepDecay = 0.98;
+
+/** Change in hit rate that restarts the hill climber with a full step. */
+constexpr double kRestartThreshold = 0.05;
+
+/** Fetches per sample as a multiple of the maximum number of pages. */
+constexpr int kSampleMultiplier = 10;
+
+} // namespace
+
+void WTinyLFUReplacementPageCache::FrequencySketch::resize(int numPages) {
+  std::uint64_t width = 16;
+  while (width < (std::uint64_t)numPages) {
+    width <<= 1;
+  }
+  if (width == width_) {
+    return;
+  }
+
+  // Counter i of a row moves to counter i mod width. Widths are powers of two,
+  // so a page ID's counters keep their low index bits. Growing copies each
+  // counter into every counter that now aliases it, and shrinking keeps the
+  // largest of the counters that fold together. Growing and then shrinking
+  // back leaves every counter as it was.
+  std::vector<std::uint64_t> table(kDepth * width / 16, 0);
+  if (width_ != 0) {
+    for (int row = 0; row < kDepth; ++row) {
+      for (std::uint64_t i = 0; i < std::max(width, width_); ++i) {
+        std::uint64_t source = row * width_ + (i & (width_ - 1));
+        std::uint64_t target = row * width + (i & (width - 1));
+        unsigned sourceShift = (source & 15) << 2;
+        unsigned targetShift = (target & 15) << 2;
+        std::uint64_t &word = table[target >> 4];
+        std::uint64_t count =
+            std::max((word >> targetShift) & 15,
+                     (table_[source >> 4] >> sourceShift) & 15);
+        word &= ~((std::uint64_t)15 << targetShift);
+        word |= count << targetShift;
+      }
+    }
+  }
+
+  table_ = std::move(table);
+  width_ = width;
+  sampleSize_ = 10 * width_;
+  if (numIncrements_ >= sampleSize_) {
+    halve();
+  }
+}
+
+void WTinyLFUReplacementPageCache::FrequencySketch::increment(
+    unsigned pageId) {
+  for (int row = 0; row < kDepth; ++row) {
+    std::uint64_t index = getIndex(pageId, row);
+    std::uint64_t &word = table_[index >> 4];
+    unsigned shift = (index & 15) << 2;
+    if (((word >> shift) & 15) < 15) {
+      word += (std::uint64_t)1 << shift;
+    }
+  }
+
+  if (++numIncrements_ >= sampleSize_) {
+    halve();
+  }
+}
+
+unsigned
+WTinyLFUReplacementPageCache::FrequencySketch::estimate(unsigned pageId) const {
+  unsigned frequency = 15;
+  for (int row = 0; row < kDepth; ++row) {
+    std::uint64_t index = getIndex(pageId, row);
+    unsigned shift = (index & 15) << 2;
+    frequency =
+        std::min(frequency, (unsigned)(table_[index >> 4] >> shift) & 15);
+  }
+  return frequency;
+}
+
+std::uint64_t
+WTinyLFUReplacementPageCache::FrequencySketch::getIndex(unsigned pageId,
+                                                        int row) const {
+  static constexpr std::uint64_t kSeeds[kDepth] = {
+      0xC3A5C85C97CB3127ULL, 0xB492B66FBE98F273ULL, 0x9AE16A3B2F90404FULL,
+      0xCBF29CE484222325ULL};
+  std::uint64_t hash = (pageId + kSeeds[row]) * 0x9E3779B97F4A7C15ULL;
+  hash ^= hash >> 32;
+  return row * width_ + (hash & (width_ - 1));
+}
+
+void WTinyLFUReplacementPageCache::FrequencySketch::halve() {
+  for (std::uint64_t &word : table_) {
+    word = (word >> 1) & 0x7777777777777777ULL;
+  }
+  numIncrements_ /= 2;
+}
+
+WTinyLFUReplacementPageCache::WTinyLFUReplacementPage::WTinyLFUReplacementPage(
+    int argPageSize, int argExtraSize, unsigned argPageId)
+    : Page(argPageSize, argExtraSize), pageId(argPageId), pinned(true),
+      segment(Segment::Window), interior(false), prev(nullptr), next(nullptr) {}
+
+void WTinyLFUReplacementPageCache::PageList::pushBack(
+    WTinyLFUReplacementPage *page) {
+  page->prev = tail;
+  page->next = nullptr;
+  if (tail != nullptr) {
+    tail->next = page;
+  } else {
+    head = page;
+  }
+  tail = page;
+}
+
+void WTinyLFUReplacementPageCache::PageList::remove(
+    WTinyLFUReplacementPage *page) {
+  if (page->prev != nullptr) {
+    page->prev->next = page->next;
+  } else {
+    head = page->next;
+  }
+  if (page->next != nullptr) {
+    page->next->prev = page->prev;
+  } else {
+    tail = page->prev;
+  }
+  page->prev = nullptr;
+  page->next = nullptr;
+}
+
+WTinyLFUReplacementPageCache::WTinyLFUReplacementPageCache(
+    int pageSize, int extraSize, double windowFraction,
+    double protectedFraction)
+    : PageCache(pageSize, extraSize), windowSize_(0), protectedSize_(0),
+      windowFraction_(windowFraction), protectedFraction_(protectedFraction),
+      windowTarget_(1.0), stepSize_(0.0), previousHitRate_(0.0),
+      sampleFetches_(0), sampleHits_(0) {
+  sketch_.resize(0);
+}
+
+WTinyLFUReplacementPageCache::~WTinyLFUReplacementPageCache() {
+  for (auto &[pageId, page] : pages_) {
+    delete page;
+  }
+}
+
+void WTinyLFUReplacementPageCache::setMaxNumPages(int maxNumPages) {
+  bool resized = maxNumPages != maxNumPages_;
+  maxNumPages_ = maxNumPages;
+
+  // Replace unpinned pages until the number of pages in the cache is less than
+  // or equal to `maxNumPages_` or only pinned pages remain.
+  WTinyLFUReplacementPage *page;
+  while (getNumPages() > maxNumPages_ && (page = replacePage()) != nullptr) {
+    delete page;
+  }
+
+  // SQLite sets the same maximum again on every PRAGMA cache_size and when a
+  // connection is set up. Keep the hill climber in that case. Otherwise,
+  // restart it for the new maximum. Resizing the sketch keeps its counts.
+  if (!resized) {
+    return;
+  }
+  windowTarget_ = std::max(1.0, windowFraction_ * maxNumPages_);
+  stepSize_ = kStepFraction * maxNumPages_;
+  previousHitRate_ = 0.0;
+  sampleFetches_ = 0;
+  sampleHits_ = 0;
+  sketch_.resize(maxNumPages_);
+}
+
+int WTinyLFUReplacementPageCache::getNumPages() const {
+  return (int)pages_.size();
+}
+
+Page *WTinyLFUReplacementPageCache::fetchPage(unsigned pageId, bool allocate) {
+  ++numFetches_;
+
+  // If the page is already in the cache, pin it and return the pointer. A page
+  // in probation is promoted to protected.
+  auto pagesIterator = pages_.find(pageId);
+  if (pagesIterator != pages_.end()) {
+    ++numHits_;
+    sketch_.increment(pageId);
+    recordFetch(true);
+    WTinyLFUReplacementPage *page = pagesIterator->second;
+    if (!page->pinned) {
+      getList(page).remove(page);
+      page->pinned = true;
+    }
+    if (page->segment == Segment::Probation) {
+      promotePage(page);
+    }
+    return page;
+  }
+
+  // The page is not already in the cache. If parameter `allocate` is false,
+  // return a null pointer. SQLite follows such a probe with an allocating
+  // fetch of the same page, so the miss is counted by that fetch alone.
+  if (!allocate) {
+    return nullptr;
+  }
+  sketch_.increment(pageId);
+  recordFetch(false);
+
+  // Parameter `allocate` is true. If the number of pages in the cache is less
+  // than the maximum, allocate a new page. Otherwise, replace an existing
+  // unpinned page. If all pages are pinned, return a null pointer.
+  WTinyLFUReplacementPage *page;
+  if (getNumPages() < maxNumPages_) {
+    page = new WTinyLFUReplacementPage(pageSize_, extraSize_, pageId);
+  } else {
+    page = replacePage();
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->pageId = pageId;
+    page->pinned = true;
+    page->interior = false;
+  }
+  page->segment = Segment::Window;
+  ++windowSize_;
+  pages_.emplace(pageId, page);
+
+  // While the cache is filling, pages leaving the window enter probation
+  // without competing for admission, interior pages last.
+  while (windowSize_ > getWindowTarget()) {
+    WTinyLFUReplacementPage *overflow =
+        window_.head != nullptr ? window_.head : interiorWindow_.head;
+    if (overflow == nullptr) {
+      break;
+    }
+    getList(overflow).remove(overflow);
+    setSegment(overflow, Segment::Probation);
+    getList(overflow).pushBack(overflow);
+  }
+  return page;
+}
+
+void WTinyLFUReplacementPageCache::unpinPage(Page *pageBase, bool discard) {
+  auto *page = (WTinyLFUReplacementPage *)pageBase;
+
+  // If discard is true or the number of pages in the cache is greater than the
+  // maximum, discard the page.
+  if (discard || getNumPages() > maxNumPages_) {
+    discardPage(page);
+    return;
+  }
+
+  // Otherwise, unpin the page. It becomes the most recently unpinned page of
+  // its segment. SQLite has written the page by now, so classify it by its
+  // page-type byte.
+  if (!page->pinned) {
+    getList(page).remove(page);
+  }
+  page->interior = isProtectedPage(page, page->pageId);
+  getList(page).pushBack(page);
+  page->pinned = false;
+}
+
+void WTinyLFUReplacementPageCache::changePageId(Page *pageBase,
+                                                unsigned newPageId) {
+  auto *page = (WTinyLFUReplacementPage *)pageBase;
+
+  // Remove the old page ID from `pages_` and change the page ID.
+  pages_.erase(page->pageId);
+  page->pageId = newPageId;
+
+  // Attempt to insert a page with page ID `newPageId` into `pages_`.
+  auto [pagesIterator, success] = pages_.emplace(newPageId, page);
+
+  // If a page with page ID `newPageId` is already in the cache, discard it.
+  if (!success) {
+    WTinyLFUReplacementPage *oldPage = pagesIterator->second;
+    pagesIterator->second = page;
+    removeFromSegment(oldPage);
+    delete oldPage;
+  }
+}
+
+void WTinyLFUReplacementPageCache::discardPages(unsigned pageIdLimit) {
+  // Discard all pages with page ID greater than or equal to `pageIdLimit`.
+  for (auto pagesIterator = pages_.begin(); pagesIterator != pages_.end();) {
+    WTinyLFUReplacementPage *page = pagesIterator->second;
+    if (page->pageId >= pageIdLimit) {
+      removeFromSegment(page);
+      delete page;
+      pagesIterator = pages_.erase(pagesIterator);
+    } else {
+      ++pagesIterator;
+    }
+  }
+}
+
+int WTinyLFUReplacementPageCache::getWindowTarget() const {
+  return (int)windowTarget_;
+}
+
+WTinyLFUReplacementPageCache::WTinyLFUReplacementPage *
+WTinyLFUReplacementPageCache::replacePage() {
+  WTinyLFUReplacementPage *candidate = window_.head;
+  WTinyLFUReplacementPage *victim =
+      probation_.head != nullptr ? probation_.head : protected_.head;
+
+  // Protected interior pages are only replaced if no other page is unpinned.
+  if (candidate == nullptr && victim == nullptr) {
+    candidate = interiorWindow_.head;
+    victim = interiorProbation_.head != nullptr ? interiorProbation_.head
+                                                : interiorProtected_.head;
+  }
+
+  WTinyLFUReplacementPage *page;
+  if (candidate != nullptr &&
+      (windowSize_ >= getWindowTarget() || victim == nullptr)) {
+    // The window is full, so its candidate is admitted to the main region only
+    // if it is estimated to be more frequent than the main region's victim.
+    if (victim != nullptr && sketch_.estimate(candidate->pageId) >
+                                 sketch_.estimate(victim->pageId)) {
+      getList(candidate).remove(candidate);
+      setSegment(candidate, Segment::Probation);
+      getList(candidate).pushBack(candidate);
+      page = victim;
+    } else {
+      page = candidate;
+    }
+  } else if (victim != nullptr) {
+    page = victim;
+  } else {
+    return nullptr;
+  }
+
+  removeFromSegment(page);
+  pages_.erase(page->pageId);
+  page->interior = false;
+  return page;
+}
+
+void WTinyLFUReplacementPageCache::promotePage(WTinyLFUReplacementPage *page) {
+  setSegment(page, Segment::Protected);
+  while (protectedSize_ > getProtectedTarget()) {
+    WTinyLFUReplacementPage *demoted = protected_.head != nullptr
+                                           ? protected_.head
+                                           : interiorProtected_.head;
+    if (demoted == nullptr) {
+      break;
+    }
+    getList(demoted).remove(demoted);
+    setSegment(demoted, Segment::Probation);
+    getList(demoted).pushBack(demoted);
+  }
+}
+
+void WTinyLFUReplacementPageCache::recordFetch(bool hit) {
+  ++sampleFetches_;
+  sampleHits_ += hit;
+  if (maxNumPages_ <= 1 || sampleFetches_ < kSampleMultiplier * maxNumPages_) {
+    return;
+  }
+
+  // Keep stepping in the same direction while the hit rate improves, and
+  // reverse otherwise. The step decays so that the target settles, but a large
+  // change in hit rate means the workload changed, so the step is restored.
+  double hitRate = (double)sampleHits_ / sampleFetches_;
+  double change = hitRate - previousHitRate_;
+  double amount = change >= 0 ? stepSize_ : -stepSize_;
+  if (std::abs(change) >= kRestartThreshold) {
+    stepSize_ = std::copysign(kStepFraction * maxNumPages_, amount);
+  } else {
+    stepSize_ = kStepDecay * amount;
+  }
+  windowTarget_ = std::clamp(windowTarget_ + amount, 1.0,
+                             std::max(1.0, maxNumPages_ - 1.0));
+
+  previousHitRate_ = hitRate;
+  sampleFetches_ = 0;
+  sampleHits_ = 0;
+}
+
+void WTinyLFUReplacementPageCache::setSegment(WTinyLFUReplacementPage *page,
+                                              Segment segment) {
+  windowSize_ -= page->segment == Segment::Window;
+  protectedSize_ -= page->segment == Segment::Protected;
+  page->segment = segment;
+  windowSize_ += segment == Segment::Window;
+  protectedSize_ += segment == Segment::Protected;
+}
+
+WTinyLFUReplacementPageCache::PageList &
+WTinyLFUReplacementPageCache::getList(WTinyLFUReplacementPage *page) {
+  switch (page->segment) {
+  case Segment::Window:
+    return page->interior ? interiorWindow_ : window_;
+  case Segment::Probation:
+    return page->interior ? interiorProbation_ : probation_;
+  default:
+    return page->interior ? interiorProtected_ : protected_;
+  }
+}
+
+void WTinyLFUReplacementPageCache::removeFromSegment(
+    WTinyLFUReplacementPage *page) {
+  if (!page->pinned) {
+    getList(page).remove(page);
+  }
+  windowSize_ -= page->segment == Segment::Window;
+  protectedSize_ -= page->segment == Segment::Protected;
+}
+
+void WTinyLFUReplacementPageCache::discardPage(WTinyLFUReplacementPage *page) {
+  removeFromSegment(page);
+  pages_.erase(page->pageId);
+  delete page;
+}
+
+int WTinyLFUReplacementPageCache::getProtectedTarget() const {
+  return (int)(protectedFraction_ * (maxNumPages_ - getWindowTarget()));
+}
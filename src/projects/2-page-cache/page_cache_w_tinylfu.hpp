@@ -0,0 +1,204 @@
+#ifndef CS564_PROJECT_PAGE_CACHE_W_TINYLFU_HPP
+#define CS564_PROJECT_PAGE_CACHE_W_TINYLFU_HPP
+
+#include "page_cache.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * W-TinyLFU page cache as described by Einziger, Friedman, and Manes. New
+ * pages enter a small LRU window. When the window is over its target size, its
+ * least recently unpinned page competes with the main region's victim, and the
+ * page with the higher estimated frequency stays. The main region is a
+ * segmented LRU with probationary and protected segments. A hill climber
+ * resizes the window from the hit rate of each sample of fetches.
+ */
+class WTinyLFUReplacementPageCache : public PageCache {
+public:
+  /**
+   * Construct a WTinyLFUReplacementPageCache.
+   * @param pageSize Page size in bytes. Assumed to be a power of two.
+   * @param extraSize Extra space in bytes. Assumed to be less than 250.
+   * @param windowFraction Initial size of the window as a fraction of the
+   * maximum number of pages.
+   * @param protectedFraction Size of the protected segment as a fraction of
+   * the main region.
+   */
+  WTinyLFUReplacementPageCache(int pageSize, int extraSize,
+                               double windowFraction = 0.01,
+                               double protectedFraction = 0.8);
+
+  ~WTinyLFUReplacementPageCache() override;
+
+  void setMaxNumPages(int maxNumPages) override;
+
+  [[nodiscard]] int getNumPages() const override;
+
+  Page *fetchPage(unsigned pageId, bool allocate) override;
+
+  void unpinPage(Page *page, bool discard) override;
+
+  void changePageId(Page *page, unsigned newPageId) override;
+
+  void discardPages(unsigned pageIdLimit) override;
+
+  /**
+   * Get the current target size of the window.
+   * @return Target size of the window in pages.
+   */
+  [[nodiscard]] int getWindowTarget() const;
+
+private:
+  /**
+   * Count-min sketch of 4-bit counters, four rows deep. Each row has one
+   * counter per page rounded up to a power of two, so the sketch costs two
+   * bytes per page. All counters are halved after every ten increments per
+   * counter in a row so that old references fade.
+   */
+  class FrequencySketch {
+  public:
+    /**
+     * Resize the sketch, keeping the estimate of every page ID at least as
+     * large as before.
+     * @param numPages Number of pages to size the sketch for.
+     */
+    void resize(int numPages);
+
+    /**
+     * Increment the counters of a page ID.
+     * @param pageId Page ID.
+     */
+    void increment(unsigned pageId);
+
+    /**
+     * Estimate the number of references to a page ID.
+     * @param pageId Page ID.
+     * @return Estimated frequency, from 0 to 15.
+     */
+    [[nodiscard]] unsigned estimate(unsigned pageId) const;
+
+  private:
+    static constexpr int kDepth = 4;
+
+    [[nodiscard]] std::uint64_t getIndex(unsigned pageId, int row) const;
+
+    void halve();
+
+    std::vector<std::uint64_t> table_;
+    std::uint64_t width_ = 0;
+    std::uint64_t numIncrements_ = 0;
+    std::uint64_t sampleSize_ = 0;
+  };
+
+  enum class Segment { Window, Probation, Protected };
+
+  struct WTinyLFUReplacementPage : public Page {
+    WTinyLFUReplacementPage(int pageSize, int extraSize, unsigned pageId);
+
+    unsigned pageId;
+    bool pinned;
+    Segment segment;
+
+    /** Whether the page was a protected interior page when last unpinned. */
+    bool interior;
+
+    /** Neighbors in the list of the page's segment. Unpinned pages only. */
+    WTinyLFUReplacementPage *prev;
+    WTinyLFUReplacementPage *next;
+  };
+
+  struct PageList {
+    WTinyLFUReplacementPage *head = nullptr;
+    WTinyLFUReplacementPage *tail = nullptr;
+
+    void pushBack(WTinyLFUReplacementPage *page);
+    void remove(WTinyLFUReplacementPage *page);
+  };
+
+  /**
+   * Choose a page to replace. If the window is at or over its target size, its
+   * least recently unpinned page is compared with the main region's victim
+   * and the less frequent page is replaced. The other page stays, moving from
+   * the window to probation if it came from the window. B-tree interior pages
+   * flagged by `isProtectedPage` are only chosen if no other page is unpinned,
+   * in which case the interior lists take the place of the segment lists.
+   * @return Pointer to a page, removed from its segment and `pages_`. Null if
+   * all pages are pinned.
+   */
+  WTinyLFUReplacementPage *replacePage();
+
+  /**
+   * Move a page from probation to protected, demoting least recently unpinned
+   * protected pages to probation while protected is over its target size.
+   * @param page Pointer to a pinned page in probation.
+   */
+  void promotePage(WTinyLFUReplacementPage *page);
+
+  /**
+   * Count a fetch toward the current sample and, at the end of a sample, move
+   * the window target one step in the direction that improved the hit rate.
+   * @param hit True if the fetch was a hit.
+   */
+  void recordFetch(bool hit);
+
+  /**
+   * Set the segment of a page, updating the segment sizes.
+   * @param page Pointer to a page.
+   * @param segment New segment.
+   */
+  void setSegment(WTinyLFUReplacementPage *page, Segment segment);
+
+  /**
+   * Get the list of unpinned pages of a page's segment.
+   * @param page Pointer to a page.
+   * @return The interior list of the segment if the page is interior, or the
+   * LRU list of the segment otherwise.
+   */
+  [[nodiscard]] PageList &getList(WTinyLFUReplacementPage *page);
+
+  /**
+   * Remove a page from the list and size of its segment.
+   * @param page Pointer to a page.
+   */
+  void removeFromSegment(WTinyLFUReplacementPage *page);
+
+  /**
+   * Remove a page from the cache and free it.
+   * @param page Pointer to a page.
+   */
+  void discardPage(WTinyLFUReplacementPage *page);
+
+  [[nodiscard]] int getProtectedTarget() const;
+
+  std::unordered_map<unsigned, WTinyLFUReplacementPage *> pages_;
+
+  /** LRU lists of unpinned pages in each segment. */
+  PageList window_;
+  PageList probation_;
+  PageList protected_;
+
+  /** LRU lists of unpinned protected interior pages in each segment. */
+  PageList interiorWindow_;
+  PageList interiorProbation_;
+  PageList interiorProtected_;
+
+  /** Number of pages in each segment, pinned or not. */
+  int windowSize_;
+  int protectedSize_;
+
+  FrequencySketch sketch_;
+
+  double windowFraction_;
+  double protectedFraction_;
+
+  /** Hill climber state. The target and step are in pages. */
+  double windowTarget_;
+  double stepSize_;
+  double previousHitRate_;
+  int sampleFetches_;
+  int sampleHits_;
+};
+
+#endif // CS564_PROJECT_PAGE_CACHE_W_TINYLFU_HPP
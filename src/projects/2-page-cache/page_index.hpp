@@ -0,0 +1,329 @@
+#ifndef CS564_PROJECT_PAGE_INDEX_HPP
+#define CS564_PROJECT_PAGE_INDEX_HPP
+
+#include "flat_page_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Index from page ID to page for use by page cache engines. SQLite page IDs
+ * are dense and start at 1, so IDs below `kMaxDirectPageId` are mapped directly
+ * through a two-level array: a growable directory of pointers to fixed-size
+ * blocks of page pointers. A lookup touches one directory entry and one block
+ * entry. Blocks are allocated on first insert and freed when they become
+ * empty. Bitmaps of allocated blocks and of occupied entries within a block
+ * keep the index ordered, so `eraseFrom` only visits the pages it removes.
+ * Larger IDs fall back to a `FlatPageMap`.
+ * @tparam PageType Page type stored by the engine.
+ */
+template <typename PageType> class PageIndex {
+public:
+  /** Number of bits of a page ID that select an entry within a block. */
+  static constexpr unsigned kBlockBits = 9;
+
+  /** Number of page pointers in a block. */
+  static constexpr unsigned kBlockSize = 1u << kBlockBits;
+
+  /** Page IDs greater than or equal to this are stored in `overflow_`. */
+  static constexpr unsigned kMaxDirectPageId = 1u << 24;
+
+  /**
+   * Find a page.
+   * @param pageId Page ID.
+   * @return Pointer to the page, or a null pointer if it is not in the index.
+   */
+  [[nodiscard]] PageType *find(unsigned pageId) const;
+
+  /**
+   * Insert a page. Assumes no page with the same page ID is in the index.
+   * @param pageId Page ID.
+   * @param page Pointer to the page. Must not be null.
+   */
+  void insert(unsigned pageId, PageType *page);
+
+  /**
+   * Insert a page, replacing any page with the same page ID.
+   * @param pageId Page ID.
+   * @param page Pointer to the page. Must not be null.
+   * @return Pointer to the replaced page, or a null pointer if there was none.
+   */
+  PageType *exchange(unsigned pageId, PageType *page);
+
+  /**
+   * Remove a page.
+   * @param pageId Page ID.
+   * @return Pointer to the removed page, or a null pointer if there was none.
+   */
+  PageType *erase(unsigned pageId);
+
+  /**
+   * Remove all pages with page ID greater than or equal to `pageIdLimit`.
+   * @tparam Function Callable taking a `PageType *`.
+   * @param pageIdLimit Page ID limit.
+   * @param function Called on each page after it is removed.
+   */
+  template <typename Function>
+  void eraseFrom(unsigned pageIdLimit, Function function);
+
+  /**
+   * Call a function on every page, in no particular order.
+   * @tparam Function Callable taking a `PageType *`.
+   * @param function Called on each page. Must not modify the index.
+   */
+  template <typename Function> void forEach(Function function) const;
+
+  /**
+   * Get the number of pages in the index.
+   * @return Number of pages.
+   */
+  [[nodiscard]] size_t size() const;
+
+private:
+  /** Number of bits in a bitmap word. */
+  static constexpr unsigned kWordBits = 64;
+
+  struct Block {
+    std::array<PageType *, kBlockSize> pages{};
+
+    /** Bitmap of non-null entries in `pages`. */
+    std::array<uint64_t, kBlockSize / kWordBits> occupied{};
+
+    /** Number of non-null entries in `pages`. */
+    unsigned numPages = 0;
+  };
+
+  /**
+   * Get the index of the lowest set bit of a non-zero word.
+   * @param word Word.
+   * @return Bit index.
+   */
+  static unsigned lowestBit(uint64_t word);
+
+  /**
+   * Get the block for a page ID in the direct-mapped range, allocating it if
+   * needed.
+   * @param blockIndex Block index.
+   * @return Reference to the block.
+   */
+  Block &getBlock(size_t blockIndex);
+
+  /**
+   * Free an empty block.
+   * @param blockIndex Block index.
+   */
+  void freeBlock(size_t blockIndex);
+
+  /**
+   * Find the first allocated block at or after a block index.
+   * @param blockIndex Block index.
+   * @return Block index, or `blocks_.size()` if there is none.
+   */
+  [[nodiscard]] size_t findBlock(size_t blockIndex) const;
+
+  /**
+   * Blocks of the direct-mapped range, indexed by page ID divided by
+   * `kBlockSize`. Null if a block holds no pages.
+   */
+  std::vector<std::unique_ptr<Block>> blocks_;
+
+  /**
+   * Bitmap of allocated blocks, so ranges of empty blocks are skipped a word
+   * at a time.
+   */
+  std::vector<uint64_t> allocated_;
+
+  /** Pages with page ID greater than or equal to `kMaxDirectPageId`. */
+  FlatPageMap<PageType> overflow_;
+
+  size_t size_ = 0;
+};
+
+template <typename PageType>
+PageType *PageIndex<PageType>::find(unsigned pageId) const {
+  if (pageId < kMaxDirectPageId) {
+    unsigned blockIndex = pageId >> kBlockBits;
+    if (blockIndex >= blocks_.size() || blocks_[blockIndex] == nullptr) {
+      return nullptr;
+    }
+    return blocks_[blockIndex]->pages[pageId & (kBlockSize - 1)];
+  }
+
+  return overflow_.find(pageId);
+}
+
+template <typename PageType>
+void PageIndex<PageType>::insert(unsigned pageId, PageType *page) {
+  exchange(pageId, page);
+}
+
+template <typename PageType>
+PageType *PageIndex<PageType>::exchange(unsigned pageId, PageType *page) {
+  PageType *oldPage;
+  if (pageId < kMaxDirectPageId) {
+    Block &block = getBlock(pageId >> kBlockBits);
+    unsigned i = pageId & (kBlockSize - 1);
+    oldPage = block.pages[i];
+    block.pages[i] = page;
+    if (oldPage == nullptr) {
+      block.occupied[i / kWordBits] |= 1ull << (i % kWordBits);
+      ++block.numPages;
+    }
+  } else {
+    oldPage = overflow_.exchange(pageId, page);
+  }
+
+  if (oldPage == nullptr) {
+    ++size_;
+  }
+  return oldPage;
+}
+
+template <typename PageType>
+PageType *PageIndex<PageType>::erase(unsigned pageId) {
+  PageType *page = nullptr;
+  if (pageId < kMaxDirectPageId) {
+    unsigned blockIndex = pageId >> kBlockBits;
+    if (blockIndex >= blocks_.size() || blocks_[blockIndex] == nullptr) {
+      return nullptr;
+    }
+
+    // Free the block if this was its last page.
+    Block &block = *blocks_[blockIndex];
+    unsigned i = pageId & (kBlockSize - 1);
+    std::swap(page, block.pages[i]);
+    if (page != nullptr) {
+      block.occupied[i / kWordBits] &= ~(1ull << (i % kWordBits));
+      if (--block.numPages == 0) {
+        freeBlock(blockIndex);
+      }
+    }
+  } else {
+    page = overflow_.erase(pageId);
+  }
+
+  if (page != nullptr) {
+    --size_;
+  }
+  return page;
+}
+
+template <typename PageType>
+template <typename Function>
+void PageIndex<PageType>::eraseFrom(unsigned pageIdLimit, Function function) {
+  // Clear direct-mapped entries from `pageIdLimit` on, visiting only allocated
+  // blocks and, within them, only occupied entries. The cost is proportional
+  // to the number of pages removed, not the number of pages in the index.
+  size_t firstBlockIndex = pageIdLimit >> kBlockBits;
+  for (size_t blockIndex = findBlock(firstBlockIndex);
+       blockIndex < blocks_.size(); blockIndex = findBlock(blockIndex + 1)) {
+    Block &block = *blocks_[blockIndex];
+    unsigned first =
+        blockIndex == firstBlockIndex ? pageIdLimit & (kBlockSize - 1) : 0;
+    for (unsigned word = first / kWordBits; word < block.occupied.size();
+         ++word) {
+      uint64_t bits = block.occupied[word];
+      if (word == first / kWordBits) {
+        bits &= ~0ull << (first % kWordBits);
+      }
+      block.occupied[word] &= ~bits;
+      for (; bits != 0; bits &= bits - 1) {
+        unsigned i = word * kWordBits + lowestBit(bits);
+        PageType *page = block.pages[i];
+        block.pages[i] = nullptr;
+        --block.numPages;
+        --size_;
+        function(page);
+      }
+    }
+    if (block.numPages == 0) {
+      freeBlock(blockIndex);
+    }
+  }
+
+  // Clear entries in `overflow_`. It is not ordered, so this scans it, but it
+  // only holds very large page IDs and is usually empty.
+  if (overflow_.size() != 0) {
+    overflow_.eraseFrom(pageIdLimit, [this, &function](PageType *page) {
+      --size_;
+      function(page);
+    });
+  }
+}
+
+template <typename PageType>
+template <typename Function>
+void PageIndex<PageType>::forEach(Function function) const {
+  for (size_t blockIndex = findBlock(0); blockIndex < blocks_.size();
+       blockIndex = findBlock(blockIndex + 1)) {
+    const Block &block = *blocks_[blockIndex];
+    for (unsigned word = 0; word < block.occupied.size(); ++word) {
+      for (uint64_t bits = block.occupied[word]; bits != 0; bits &= bits - 1) {
+        function(block.pages[word * kWordBits + lowestBit(bits)]);
+      }
+    }
+  }
+
+  overflow_.forEach(function);
+}
+
+template <typename PageType> size_t PageIndex<PageType>::size() const {
+  return size_;
+}
+
+template <typename PageType>
+unsigned PageIndex<PageType>::lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctzll(word);
+#else
+  unsigned bit = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+template <typename PageType>
+typename PageIndex<PageType>::Block &
+PageIndex<PageType>::getBlock(size_t blockIndex) {
+  if (blockIndex >= blocks_.size()) {
+    blocks_.resize(blockIndex + 1);
+    allocated_.resize(blockIndex / kWordBits + 1);
+  }
+  if (blocks_[blockIndex] == nullptr) {
+    blocks_[blockIndex] = std::make_unique<Block>();
+    allocated_[blockIndex / kWordBits] |= 1ull << (blockIndex % kWordBits);
+  }
+  return *blocks_[blockIndex];
+}
+
+template <typename PageType>
+void PageIndex<PageType>::freeBlock(size_t blockIndex) {
+  blocks_[blockIndex].reset();
+  allocated_[blockIndex / kWordBits] &= ~(1ull << (blockIndex % kWordBits));
+}
+
+template <typename PageType>
+size_t PageIndex<PageType>::findBlock(size_t blockIndex) const {
+  size_t word = blockIndex / kWordBits;
+  if (word >= allocated_.size()) {
+    return blocks_.size();
+  }
+
+  uint64_t bits = allocated_[word] & (~0ull << (blockIndex % kWordBits));
+  while (bits == 0) {
+    if (++word == allocated_.size()) {
+      return blocks_.size();
+    }
+    bits = allocated_[word];
+  }
+  return word * kWordBits + lowestBit(bits);
+}
+
+#endif // CS564_PROJECT_PAGE_INDEX_HPP
@@ -0,0 +1,85 @@
+#include "flat_page_map.hpp"
+#include "utilities/test.hpp"
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+void flatPageMapFind() {
+  FlatPageMap<int> map;
+  int pages[3];
+  TEST_ASSERT(map.find(1) == nullptr, "expected null pointer");
+  map.insert(1, &pages[0]);
+  map.insert(17, &pages[1]);
+  map.insert(4000000000u, &pages[2]);
+  TEST_ASSERT(map.size() == 3, "incorrect number of pages");
+  TEST_ASSERT(map.find(1) == &pages[0], "incorrect page");
+  TEST_ASSERT(map.find(17) == &pages[1], "incorrect page");
+  TEST_ASSERT(map.find(4000000000u) == &pages[2], "incorrect page");
+  TEST_ASSERT(map.find(2) == nullptr, "expected null pointer");
+}
+
+void flatPageMapExchange() {
+  FlatPageMap<int> map;
+  int pages[2];
+  TEST_ASSERT(map.exchange(1, &pages[0]) == nullptr, "expected null pointer");
+  TEST_ASSERT(map.exchange(1, &pages[1]) == &pages[0], "incorrect page");
+  TEST_ASSERT(map.size() == 1, "incorrect number of pages");
+  TEST_ASSERT(map.erase(1) == &pages[1], "incorrect page");
+  TEST_ASSERT(map.erase(1) == nullptr, "expected null pointer");
+  TEST_ASSERT(map.size() == 0, "incorrect number of pages");
+}
+
+void flatPageMapRandom() {
+  // Mix inserts and erases over a small range of page IDs, so the table
+  // grows, fills with deleted slots, and rehashes. Compare against
+  // std::unordered_map after each operation.
+  FlatPageMap<int> map;
+  std::unordered_map<unsigned, int *> expected;
+  std::vector<int> pages(4096);
+  std::minstd_rand randomGenerator(1);
+  std::uniform_int_distribution<unsigned> pageIdDistribution(0, 4095);
+  for (int i = 0; i < 100000; ++i) {
+    unsigned pageId = pageIdDistribution(randomGenerator) * 7919;
+    int *page = &pages[pageId / 7919];
+    int *expectedPage = expected.count(pageId) != 0 ? page : nullptr;
+    if (randomGenerator() % 3 == 0) {
+      TEST_ASSERT(map.erase(pageId) == expectedPage, "incorrect page");
+      expected.erase(pageId);
+      expectedPage = nullptr;
+    } else {
+      TEST_ASSERT(map.exchange(pageId, page) == expectedPage,
+                  "incorrect page");
+      expected[pageId] = page;
+      expectedPage = page;
+    }
+    TEST_ASSERT(map.find(pageId) == expectedPage, "incorrect page");
+  }
+  TEST_ASSERT(map.size() == expected.size(), "incorrect number of pages");
+  size_t numPages = 0;
+  map.forEach([&numPages](int *) { ++numPages; });
+  TEST_ASSERT(numPages == expected.size(), "incorrect number of pages");
+}
+
+void flatPageMapEraseFrom() {
+  FlatPageMap<int> map;
+  std::vector<int> pages(1000);
+  for (unsigned pageId = 1; pageId < 1000; ++pageId) {
+    map.insert(pageId, &pages[pageId]);
+  }
+  int numErased = 0;
+  map.eraseFrom(300, [&numErased](int *) { ++numErased; });
+  TEST_ASSERT(numErased == 700, "incorrect number of pages removed");
+  TEST_ASSERT(map.size() == 299, "incorrect number of pages");
+  TEST_ASSERT(map.find(299) == &pages[299], "incorrect page");
+  TEST_ASSERT(map.find(300) == nullptr, "expected null pointer");
+}
+
+int main() {
+  TEST_RUN(flatPageMapFind);
+  TEST_RUN(flatPageMapExchange);
+  TEST_RUN(flatPageMapRandom);
+  TEST_RUN(flatPageMapEraseFrom);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,63 @@
+#include "page_cache_2q.hpp"
+#include "test_page_cache_common.hpp"
+
+void twoQReplacement1() {
+  TwoQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void twoQReplacement2() {
+  TwoQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(4);
+  Page *page1, *page2;
+  for (unsigned pageId = 1; pageId < 6; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  // Page 1 was replaced from A1in, so fetching it again moves it to Am.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 6; pageId < 20; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void twoQReplacement3() {
+  TwoQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<TwoQReplacementPageCache>();
+
+  TEST_RUN(twoQReplacement1);
+  TEST_RUN(twoQReplacement2);
+  TEST_RUN(twoQReplacement3);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,81 @@
+#include "page_cache_arc.hpp"
+#include "test_page_cache_common.hpp"
+
+void arcReplacement1() {
+  ARCReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void arcReplacement2() {
+  ARCReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 is in T2 and should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void arcReplacement3() {
+  ARCReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  // Page 2 is in B1. Fetching it grows the target size of T1, so page 1 is
+  // replaced from T2 instead of page 3 from T1.
+  page2 = pageCache.fetchPage(2, true);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 != nullptr, "expected valid pointer");
+}
+
+void arcReplacement4() {
+  ARCReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<ARCReplacementPageCache>();
+
+  TEST_RUN(arcReplacement1);
+  TEST_RUN(arcReplacement2);
+  TEST_RUN(arcReplacement3);
+  TEST_RUN(arcReplacement4);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,58 @@
+#include "page_cache_car.hpp"
+#include "test_page_cache_common.hpp"
+
+void carReplacement1() {
+  CARReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void carReplacement2() {
+  CARReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 moved to T2 and should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void carReplacement3() {
+  CARReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<CARReplacementPageCache>();
+
+  TEST_RUN(carReplacement1);
+  TEST_RUN(carReplacement2);
+  TEST_RUN(carReplacement3);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,90 @@
+#include "page_cache_clock.hpp"
+#include "test_page_cache_common.hpp"
+
+void clockReplacement1() {
+  ClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void clockReplacement2() {
+  ClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3, *page4;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  page4 = pageCache.fetchPage(4, true);
+  pageCache.unpinPage(page4, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(5, true);
+  // Page 2 was referenced again and should have been given a second chance.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+  page3 = pageCache.fetchPage(3, false);
+  // Page 3 should have been replaced.
+  TEST_ASSERT(page3 == nullptr, "expected null pointer");
+}
+
+void clockReplacement3() {
+  ClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void clockReplacement4() {
+  ClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3, *page4;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  page1 = pageCache.fetchPage(1, false);
+  pageCache.unpinPage(page1, true);
+  // Page 4 takes its place just behind the hand, after pages 2 and 3.
+  page4 = pageCache.fetchPage(4, true);
+  pageCache.unpinPage(page4, false);
+  pageCache.fetchPage(5, true);
+  // The hand cleared every reference bit and came back to page 2 first.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 != nullptr, "expected valid pointer");
+  page4 = pageCache.fetchPage(4, false);
+  TEST_ASSERT(page4 != nullptr, "expected valid pointer");
+}
+
+int main() {
+  commonAll<ClockReplacementPageCache>();
+
+  TEST_RUN(clockReplacement1);
+  TEST_RUN(clockReplacement2);
+  TEST_RUN(clockReplacement3);
+  TEST_RUN(clockReplacement4);
+
+  return TEST_EXIT_CODE;
+}
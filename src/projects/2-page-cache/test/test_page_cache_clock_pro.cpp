@@ -0,0 +1,157 @@
+#include "page_cache_clock_pro.hpp"
+#include "test_page_cache_common.hpp"
+
+const char *databaseName = "clock_pro.sqlite";
+
+void clockProReplacement1() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void clockProReplacement2() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 was referenced while cold, became hot, and should have survived the
+  // scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void clockProReplacement3() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 5; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  // Page 1 was replaced but is still in its test period, so fetching it again
+  // makes it hot.
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 5; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void clockProReplacement4() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void clockProReplacementCollidingHands() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3, *page4;
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page4 = pageCache.fetchPage(4, true);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  // Pages 2 and 3 are test entries. Shrinking the cache replaces page 1 while
+  // the test hand points at it, leaving more test entries than the cache
+  // holds. The older test entries should be removed, and page 1 should keep
+  // its test period.
+  pageCache.setMaxNumPages(1);
+  pageCache.unpinPage(page4, false);
+  pageCache.setMaxNumPages(3);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 5; pageId < 11; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  // Page 1 was fetched during its test period, became hot, and should have
+  // survived the scan.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void clockProReplacementTestPeriod() {
+  ClockProReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page;
+  for (unsigned pageId : {2, 1, 4, 2, 4, 1}) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // Page 2 was fetched during its test period and became hot. The hot hand then
+  // ended the test period of page 4, so fetching page 4 again only started a
+  // new test period, and page 4 was replaced before page 2.
+  page = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+  page = pageCache.fetchPage(4, false);
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+}
+
+void clockProReplacementSQLScan() {
+  int numHits;
+  commonSQLScan<ClockProReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 262, "incorrect number of hits");
+}
+
+void clockProReplacementSQLScanWithHotSet() {
+  int numHits;
+  commonSQLScanWithHotSet<ClockProReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 320, "incorrect number of hits");
+}
+
+void clockProReplacementSQLUniformRandom() {
+  int numHits;
+  commonSQLUniformRandom<ClockProReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 292, "incorrect number of hits");
+}
+
+void clockProReplacementSQLBinomialRandom() {
+  int numHits;
+  commonSQLBinomialRandom<ClockProReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 298, "incorrect number of hits");
+}
+
+int main() {
+  commonAll<ClockProReplacementPageCache>();
+
+  TEST_RUN(clockProReplacement1);
+  TEST_RUN(clockProReplacement2);
+  TEST_RUN(clockProReplacement3);
+  TEST_RUN(clockProReplacement4);
+  TEST_RUN(clockProReplacementCollidingHands);
+  TEST_RUN(clockProReplacementTestPeriod);
+
+  return TEST_EXIT_CODE;
+}
@@ -75,6 +75,36 @@ template <typename T> void commonDiscardPages() {
   TEST_ASSERT(page2 == nullptr, "expected null pointer");
 }
 
+template <typename T> void commonProtectInteriorPages() {
+  T pageCache(4096, 8);
+  pageCache.setProtectInteriorPages(true);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3;
+  // Page 1 is an interior table page. Its page-type byte follows the database
+  // header.
+  page1 = pageCache.fetchPage(1, true);
+  ((unsigned char *)page1->getBuffer())[100] = 0x05;
+  pageCache.unpinPage(page1, false);
+  // Page 2 is a leaf table page.
+  page2 = pageCache.fetchPage(2, true);
+  ((unsigned char *)page2->getBuffer())[0] = 0x0d;
+  pageCache.unpinPage(page2, false);
+  // Page 3 is an interior index page.
+  page3 = pageCache.fetchPage(3, true);
+  ((unsigned char *)page3->getBuffer())[0] = 0x02;
+  pageCache.unpinPage(page3, false);
+  // Page 2 was the only unpinned page that is not an interior page, so it
+  // should have been replaced.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  // Only interior pages are unpinned, so one of them should be replaced.
+  Page *page4 = pageCache.fetchPage(4, true);
+  TEST_ASSERT(page4 != nullptr, "expected valid pointer");
+}
+
 void loadSQLiteDatabase(const char *name) {
   sqlite::Database db(name);
   sqlite::Connection conn;
@@ -82,6 +112,7 @@ void loadSQLiteDatabase(const char *name) {
   db.connect(conn).expect(SQLITE_OK);
 
   conn.execute("DROP TABLE IF EXISTS T");
+  conn.execute("DROP TABLE IF EXISTS U");
 
   conn.execute("CREATE TABLE T (a INTEGER PRIMARY KEY, b INTEGER)")
       .expect(SQLITE_OK);
@@ -94,14 +125,20 @@ void loadSQLiteDatabase(const char *name) {
         .expect(SQLITE_OK);
   }
 
+  // U is a copy of T that is created after it, so that the pages of T keep
+  // their numbers.
+  conn.execute("CREATE TABLE U (a INTEGER PRIMARY KEY, b INTEGER)")
+      .expect(SQLITE_OK);
+  conn.execute("INSERT INTO U SELECT * FROM T").expect(SQLITE_OK);
+
   conn.commit().expect(SQLITE_OK);
 }
 
-template <typename T, typename F>
+template <typename T, bool protectInteriorPages = false, typename F>
 void commonSQLRun(const char *databaseName, F &&f, int &numHits) {
   static T *pageCache;
 
-  PageCacheMethods<T> pageCacheMethods;
+  PageCacheMethods<T, protectInteriorPages> pageCacheMethods;
   sqlite::shutdown().expect(SQLITE_OK);
   sqlite::config(SQLITE_CONFIG_PCACHE2, &pageCacheMethods).expect(SQLITE_OK);
   sqlite::initialize().expect(SQLITE_OK);
@@ -177,6 +214,26 @@ void commonSQLBinomialRandom(const char *databaseName, int &numHits) {
       numHits);
 }
 
+template <typename T, bool protectInteriorPages = false>
+void commonSQLScanWithLookups(const char *databaseName, int &numHits) {
+  std::minstd_rand rng(0); // NOLINT(cert-msc51-cpp)
+  std::uniform_int_distribution<int> dis(0, numRows - 1);
+
+  commonSQLRun<T, protectInteriorPages>(
+      databaseName,
+      [&](sqlite::Connection &conn) {
+        for (int i = 0; i < 10; ++i) {
+          conn.execute("SELECT SUM(b) FROM T").expect(SQLITE_OK);
+          for (int j = 0; j < 10; ++j) {
+            conn.execute("SELECT b FROM U WHERE a = " +
+                         std::to_string(dis(rng)))
+                .expect(SQLITE_OK);
+          }
+        }
+      },
+      numHits);
+}
+
 template <typename T> void commonAll() {
   TEST_RUN(commonFetchMiss<T>);
   TEST_RUN(commonFetchTwice<T>);
@@ -185,6 +242,7 @@ template <typename T> void commonAll() {
   TEST_RUN(commonChangePageId<T>);
   TEST_RUN(commonDiscardPages<T>);
   TEST_RUN(commonNumPages<T>);
+  TEST_RUN(commonProtectInteriorPages<T>);
 }
 
 #endif // CS564_PROJECT_TEST_PAGE_CACHE_COMMON_HPP
@@ -0,0 +1,60 @@
+#include "page_cache_gclock.hpp"
+#include "test_page_cache_common.hpp"
+
+void gclockReplacement1() {
+  GClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 was hit and should have outlasted page 2.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void gclockReplacement2() {
+  GClockReplacementPageCache pageCache(4096, 8, 1, 4);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 5; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 was hit with a large weight and should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void gclockReplacement3() {
+  GClockReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<GClockReplacementPageCache>();
+
+  TEST_RUN(gclockReplacement1);
+  TEST_RUN(gclockReplacement2);
+  TEST_RUN(gclockReplacement3);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,87 @@
+#include "page_cache_lfuda.hpp"
+#include "test_page_cache_common.hpp"
+
+void lfudaReplacement1() {
+  LFUDAReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (unsigned pageId = 2; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(4, true);
+  // Page 1 was fetched most often, so page 2 should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void lfudaReplacement2() {
+  LFUDAReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  for (int i = 0; i < 5; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (unsigned pageId = 2; pageId < 8; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Each replacement raised the age of the cache, so page 1 should have been
+  // overtaken by new pages and replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void lfudaReplacement3() {
+  LFUDAReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void lfudaReplacement4() {
+  LFUDAReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+  }
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 2; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(4, true);
+  // Page 1 kept the hits it got while pinned, so page 2 should have been
+  // replaced even though page 1 was unpinned first.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+int main() {
+  commonAll<LFUDAReplacementPageCache>();
+
+  TEST_RUN(lfudaReplacement1);
+  TEST_RUN(lfudaReplacement2);
+  TEST_RUN(lfudaReplacement3);
+  TEST_RUN(lfudaReplacement4);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,90 @@
+#include "page_cache_lirs.hpp"
+#include "test_page_cache_common.hpp"
+
+void lirsReplacement1() {
+  LIRSReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  pageCache.fetchPage(4, true);
+  // Pages 1 and 2 are LIR, so HIR page 3 should have been replaced.
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 == nullptr, "expected null pointer");
+  TEST_ASSERT(pageCache.getNumNonResident() == 1,
+              "expected one non-resident entry");
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+  // Page 2 left the bottom of S, so page 3 should have been pruned.
+  TEST_ASSERT(pageCache.getNumNonResident() == 0,
+              "expected no non-resident entries");
+}
+
+void lirsReplacement2() {
+  LIRSReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3, *page4;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page4 = pageCache.fetchPage(4, true);
+  pageCache.unpinPage(page4, false);
+  // Page 3 is still in S, so it returns as LIR and page 2 becomes HIR.
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(5, true);
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 != nullptr, "expected valid pointer");
+}
+
+void lirsReplacement3() {
+  LIRSReplacementPageCache pageCache(4096, 8, 0.01, 0.0);
+  pageCache.setMaxNumPages(3);
+  Page *page;
+  for (unsigned pageId = 1; pageId < 10; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // Non-resident entries should not be kept.
+  TEST_ASSERT(pageCache.getNumNonResident() == 0,
+              "expected no non-resident entries");
+}
+
+void lirsReplacement4() {
+  LIRSReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  pageCache.fetchPage(4, true);
+  page1 = pageCache.fetchPage(1, false);
+  // HIR page 3 is pinned, so LIR page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<LIRSReplacementPageCache>();
+
+  TEST_RUN(lirsReplacement1);
+  TEST_RUN(lirsReplacement2);
+  TEST_RUN(lirsReplacement3);
+  TEST_RUN(lirsReplacement4);
+
+  return TEST_EXIT_CODE;
+}
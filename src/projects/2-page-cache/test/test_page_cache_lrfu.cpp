@@ -0,0 +1,64 @@
+#include "page_cache_lrfu.hpp"
+#include "test_page_cache_common.hpp"
+
+void lrfuReplacement1() {
+  LRFUReplacementPageCache pageCache(4096, 8, 1.0);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  // With lambda equal to 1, page 1 was fetched least recently and should have
+  // been replaced.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void lrfuReplacement2() {
+  LRFUReplacementPageCache pageCache(4096, 8, 1.0);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.setLambda(0.0);
+  pageCache.fetchPage(3, true);
+  // With lambda equal to 0, page 2 was fetched least frequently and should
+  // have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void lrfuReplacement3() {
+  LRFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<LRFUReplacementPageCache>();
+
+  TEST_RUN(lrfuReplacement1);
+  TEST_RUN(lrfuReplacement2);
+  TEST_RUN(lrfuReplacement3);
+
+  return TEST_EXIT_CODE;
+}
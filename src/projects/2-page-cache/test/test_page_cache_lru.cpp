@@ -64,6 +64,33 @@ void lruReplacement4() {
   TEST_ASSERT(page2 == nullptr, "expected null pointer");
 }
 
+void lruReplacement5() {
+  LRUReplacementPageCache pageCache(4096, 8);
+  pageCache.setProtectInteriorPages(true);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3;
+  // Page 1 is an interior table page. Its page-type byte follows the database
+  // header.
+  page1 = pageCache.fetchPage(1, true);
+  ((unsigned char *)page1->getBuffer())[100] = 0x05;
+  pageCache.unpinPage(page1, false);
+  // Page 2 is a leaf table page.
+  page2 = pageCache.fetchPage(2, true);
+  ((unsigned char *)page2->getBuffer())[0] = 0x0d;
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is an interior page, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  // Page 3 is an interior index page.
+  ((unsigned char *)page3->getBuffer())[0] = 0x02;
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Only interior pages remain, so page 1 should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
 void lruReplacementSQLScan() {
   int numHits;
   commonSQLScan<LRUReplacementPageCache>(databaseName, numHits);
@@ -95,6 +122,7 @@ int main() {
   TEST_RUN(lruReplacement2);
   TEST_RUN(lruReplacement3);
   TEST_RUN(lruReplacement4);
+  TEST_RUN(lruReplacement5);
 
   return TEST_EXIT_CODE;
 }
@@ -1,4 +1,5 @@
 #include "page_cache_lru_2.hpp"
+#include "page_cache_lru_k.hpp"
 #include "test_page_cache_common.hpp"
 
 const char *databaseName = "lru2.sqlite";
@@ -104,6 +105,87 @@ void lru2ReplacementSQLBinomialRandom() {
   TEST_ASSERT(numHits == 298, "incorrect number of hits");
 }
 
+void lruKReplacementCorrelated() {
+  LRUKReplacementPageCache<2> pageCache(4096, 8, 1);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // The two unpins of page 1 are correlated, so page 1 has one reference and
+  // should have been replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void lruKReplacementCorrelatedBoundary() {
+  LRUKReplacementPageCache<2> pageCache(4096, 8, 2);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  // This unpin is exactly two unpins after the previous unpin of page 1, so it
+  // is correlated and page 1 keeps one reference.
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  // Page 1 is first in replacement order but still inside its period. Page 2
+  // was last unpinned exactly two unpins ago, so it is outside its period and
+  // should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void lruKReplacementRetained() {
+  LRUKReplacementPageCache<2> pageCache(4096, 8, 0, 100);
+  pageCache.setMaxNumPages(1);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  pageCache.setMaxNumPages(2);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  // Page 1 kept its first reference while it was not cached, so page 3 should
+  // have been replaced.
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void lruKReplacement3() {
+  LRUKReplacementPageCache<3> pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (int i = 0; i < 2; ++i) {
+    page2 = pageCache.fetchPage(2, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(3, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 2 has fewer than three references and should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
 int main() {
   commonAll<LRU2ReplacementPageCache>();
 
@@ -113,5 +195,13 @@ int main() {
   TEST_RUN(lru2Replacement4);
   TEST_RUN(lru2Replacement5);
 
+  commonAll<LRUKReplacementPageCache<2>>();
+  commonAll<LRUKReplacementPageCache<3>>();
+
+  TEST_RUN(lruKReplacementCorrelated);
+  TEST_RUN(lruKReplacementCorrelatedBoundary);
+  TEST_RUN(lruKReplacementRetained);
+  TEST_RUN(lruKReplacement3);
+
   return TEST_EXIT_CODE;
 }
@@ -0,0 +1,164 @@
+#include "page_cache_midpoint_lru.hpp"
+#include "test_page_cache_common.hpp"
+
+const char *databaseName = "midpoint_lru.sqlite";
+
+/**
+ * Fill a cache of eight pages with pages 1 to 8, fetching each page twice so
+ * that every page that reaches the old sublist is promoted once.
+ */
+void midpointLRUWarmUp(MidpointLRUReplacementPageCache &pageCache) {
+  pageCache.setMaxNumPages(8);
+  pageCache.setOldBlockFetches(0);
+  Page *page;
+  for (int i = 0; i < 2; ++i) {
+    for (unsigned pageId = 1; pageId < 9; ++pageId) {
+      page = pageCache.fetchPage(pageId, true);
+      pageCache.unpinPage(page, false);
+    }
+  }
+  pageCache.setOldBlockFetches(1000);
+}
+
+void midpointLRUReplacement1() {
+  MidpointLRUReplacementPageCache pageCache(4096, 8);
+  midpointLRUWarmUp(pageCache);
+  Page *page;
+  for (unsigned pageId = 10; pageId < 30; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // The scan only replaced pages in the old sublist, so young page 4 should
+  // have survived and old page 3 should have been replaced.
+  page = pageCache.fetchPage(4, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+  page = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+}
+
+void midpointLRUReplacement2() {
+  MidpointLRUReplacementPageCache pageCache(4096, 8);
+  midpointLRUWarmUp(pageCache);
+  pageCache.setOldBlockFetches(5);
+  Page *page10, *page11, *page;
+  page10 = pageCache.fetchPage(10, true);
+  pageCache.unpinPage(page10, false);
+  for (int i = 0; i < 5; ++i) {
+    pageCache.fetchPage(100, false);
+  }
+  // Page 10 stayed in the old sublist long enough to become young. Page 11 is
+  // fetched again right after entering the old sublist, so it stays old.
+  page10 = pageCache.fetchPage(10, true);
+  pageCache.unpinPage(page10, false);
+  for (int i = 0; i < 2; ++i) {
+    page11 = pageCache.fetchPage(11, true);
+    pageCache.unpinPage(page11, false);
+  }
+  for (unsigned pageId = 20; pageId < 40; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  page10 = pageCache.fetchPage(10, false);
+  TEST_ASSERT(page10 != nullptr, "expected valid pointer");
+  page11 = pageCache.fetchPage(11, false);
+  TEST_ASSERT(page11 == nullptr, "expected null pointer");
+}
+
+void midpointLRUReplacement3() {
+  MidpointLRUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void midpointLRUReplacement4() {
+  MidpointLRUReplacementPageCache pageCache(4096, 8);
+  midpointLRUWarmUp(pageCache);
+  pageCache.setOldBlockFetches(0);
+  pageCache.setOldBlockRatio(0.5);
+  pageCache.setOldRatio(0.5);
+  Page *page10, *page11, *page;
+  // Page 10 is fetched again right after entering the old sublist, so it stays
+  // old.
+  for (int i = 0; i < 2; ++i) {
+    page10 = pageCache.fetchPage(10, true);
+    pageCache.unpinPage(page10, false);
+  }
+  page11 = pageCache.fetchPage(11, true);
+  pageCache.unpinPage(page11, false);
+  page = pageCache.fetchPage(12, true);
+  pageCache.unpinPage(page, false);
+  // Only one page entered the old sublist of four pages after page 11, so page
+  // 11 stays old. Two entered after page 10, so page 10 becomes young.
+  page11 = pageCache.fetchPage(11, true);
+  pageCache.unpinPage(page11, false);
+  page10 = pageCache.fetchPage(10, true);
+  pageCache.unpinPage(page10, false);
+  for (unsigned pageId = 20; pageId < 40; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  page10 = pageCache.fetchPage(10, false);
+  TEST_ASSERT(page10 != nullptr, "expected valid pointer");
+  page11 = pageCache.fetchPage(11, false);
+  TEST_ASSERT(page11 == nullptr, "expected null pointer");
+}
+
+void midpointLRUReplacementSQLScan() {
+  int numHits;
+  commonSQLScan<MidpointLRUReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 262, "incorrect number of hits");
+}
+
+void midpointLRUReplacementSQLScanWithHotSet() {
+  int numHits;
+  commonSQLScanWithHotSet<MidpointLRUReplacementPageCache>(databaseName,
+                                                           numHits);
+  // LRU gets 331 hits.
+  TEST_ASSERT(numHits == 332, "incorrect number of hits");
+}
+
+void midpointLRUReplacementSQLUniformRandom() {
+  int numHits;
+  commonSQLUniformRandom<MidpointLRUReplacementPageCache>(databaseName,
+                                                          numHits);
+  TEST_ASSERT(numHits == 292, "incorrect number of hits");
+}
+
+void midpointLRUReplacementSQLBinomialRandom() {
+  int numHits;
+  commonSQLBinomialRandom<MidpointLRUReplacementPageCache>(databaseName,
+                                                           numHits);
+  TEST_ASSERT(numHits == 298, "incorrect number of hits");
+}
+
+void midpointLRUReplacementSQLScanWithLookups() {
+  int numHits;
+  commonSQLScanWithLookups<MidpointLRUReplacementPageCache>(databaseName,
+                                                            numHits);
+  TEST_ASSERT(numHits == 337, "incorrect number of hits");
+  // The root pages of T and U are interior pages, so they are kept through
+  // the scans of T when they are protected.
+  commonSQLScanWithLookups<MidpointLRUReplacementPageCache, true>(databaseName,
+                                                                  numHits);
+  TEST_ASSERT(numHits == 462, "incorrect number of hits");
+}
+
+int main() {
+  commonAll<MidpointLRUReplacementPageCache>();
+
+  TEST_RUN(midpointLRUReplacement1);
+  TEST_RUN(midpointLRUReplacement2);
+  TEST_RUN(midpointLRUReplacement3);
+  TEST_RUN(midpointLRUReplacement4);
+
+  return TEST_EXIT_CODE;
+}
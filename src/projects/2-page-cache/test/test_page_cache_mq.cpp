@@ -0,0 +1,118 @@
+#include "page_cache_mq.hpp"
+#include "test_page_cache_common.hpp"
+
+const char *databaseName = "mq.sqlite";
+
+void mqReplacement1() {
+  MQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (int i = 0; i < 4; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (unsigned pageId = 2; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(4, true);
+  // Page 1 is in a higher queue, so page 2 should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void mqReplacement2() {
+  MQReplacementPageCache pageCache(4096, 8, 8, 100.0);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3;
+  for (int i = 0; i < 2; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  // Page 2 is in Qout, so it resumes its count and joins page 1's queue.
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(4, true);
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+}
+
+void mqReplacement3() {
+  MQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  for (int i = 0; i < 8; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (int i = 0; i < 10; ++i) {
+    pageCache.fetchPage(100, false);
+  }
+  for (int i = 0; i < 2; ++i) {
+    page2 = pageCache.fetchPage(2, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(3, true);
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 expired and was demoted below page 2, so it should have been
+  // replaced.
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void mqReplacement4() {
+  MQReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void mqReplacementSQLScan() {
+  int numHits;
+  commonSQLScan<MQReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 262, "incorrect number of hits");
+}
+
+void mqReplacementSQLScanWithHotSet() {
+  int numHits;
+  commonSQLScanWithHotSet<MQReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 333, "incorrect number of hits");
+}
+
+void mqReplacementSQLUniformRandom() {
+  int numHits;
+  commonSQLUniformRandom<MQReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 292, "incorrect number of hits");
+}
+
+void mqReplacementSQLBinomialRandom() {
+  int numHits;
+  commonSQLBinomialRandom<MQReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 298, "incorrect number of hits");
+}
+
+int main() {
+  commonAll<MQReplacementPageCache>();
+
+  TEST_RUN(mqReplacement1);
+  TEST_RUN(mqReplacement2);
+  TEST_RUN(mqReplacement3);
+  TEST_RUN(mqReplacement4);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,124 @@
+#include "page_cache_lru.hpp"
+#include "page_cache_optimal.hpp"
+#include "test_page_cache_common.hpp"
+
+const char *databaseName = "optimal.sqlite";
+
+void optimalReplacement1() {
+  OptimalReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  pageCache.setTrace({1, 2, 3, 1, 2});
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  // Page 2 is used after page 1, so page 2 should have been replaced.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void optimalReplacement2() {
+  OptimalReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  std::vector<unsigned> trace;
+  for (int i = 0; i < 10; ++i) {
+    for (unsigned pageId = 1; pageId < 5; ++pageId) {
+      trace.push_back(pageId);
+    }
+  }
+  pageCache.setTrace(trace);
+  Page *page;
+  for (unsigned pageId : trace) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // LRU has no hits on this loop, but OPT misses only 16 of 40 fetches.
+  TEST_ASSERT(pageCache.getNumHits() == 24, "expected 24 hits");
+}
+
+void optimalReplacement3() {
+  OptimalReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  pageCache.setTrace({1, 2, 3, 4, 3, 2});
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  // Page 1 is pinned and never used again, so page 2 should have been
+  // replaced.
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 != nullptr, "expected valid pointer");
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void optimalReplacement4() {
+  OptimalReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  pageCache.setTrace({1, 2, 3, 2, 1});
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  // Page 2 is fetched twice, but only once in the trace.
+  for (int i = 0; i < 2; ++i) {
+    page2 = pageCache.fetchPage(2, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  // Page 2 is used before page 1, so page 1 should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void optimalReplacement5() {
+  OptimalReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  pageCache.setTrace({1, 4, 2, 3, 2, 1});
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  // Page 4 is in the trace, but it is never fetched.
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  // Page 2 is used before page 1, so page 1 should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void optimalReplacementSQLScanWithHotSet() {
+  int numHits;
+  using TraceRecordingLRU = TraceRecordingPageCache<LRUReplacementPageCache>;
+  TraceRecordingLRU::getTrace().clear();
+  commonSQLScanWithHotSet<TraceRecordingLRU>(databaseName, numHits);
+  OptimalReplacementPageCache::setDefaultTrace(TraceRecordingLRU::getTrace());
+  commonSQLScanWithHotSet<OptimalReplacementPageCache>(databaseName, numHits);
+  // LRU-2 gets 352 hits.
+  TEST_ASSERT(numHits == 407, "incorrect number of hits");
+}
+
+int main() {
+  commonAll<OptimalReplacementPageCache>();
+
+  TEST_RUN(optimalReplacement1);
+  TEST_RUN(optimalReplacement2);
+  TEST_RUN(optimalReplacement3);
+  TEST_RUN(optimalReplacement4);
+  TEST_RUN(optimalReplacement5);
+
+  return TEST_EXIT_CODE;
+}
@@ -1,7 +1,54 @@
 #include "page_cache_random.hpp"
 #include "test_page_cache_common.hpp"
 
+void randomReplacement1() {
+  RandomReplacementPageCache pageCache(4096, 8);
+  pageCache.setProtectInteriorPages(true);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2;
+  // Page 1 is an interior table page. Its page-type byte follows the database
+  // header.
+  page1 = pageCache.fetchPage(1, true);
+  ((unsigned char *)page1->getBuffer())[100] = 0x05;
+  pageCache.unpinPage(page1, false);
+  // Page 2 is a leaf table page.
+  page2 = pageCache.fetchPage(2, true);
+  ((unsigned char *)page2->getBuffer())[0] = 0x0d;
+  pageCache.unpinPage(page2, false);
+  pageCache.fetchPage(3, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is an interior page, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void randomReplacement2() {
+  RandomReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Pages 1 and 3 are pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  pageCache.unpinPage(page1, false);
+  pageCache.unpinPage(page3, false);
+  pageCache.setMaxNumPages(1);
+  // Page 4 is pinned, so pages 1 and 3 should have been discarded.
+  TEST_ASSERT(pageCache.getNumPages() == 1, "expected one page");
+  TEST_ASSERT(pageCache.fetchPage(4, false) != nullptr,
+              "expected valid pointer");
+}
+
 int main() {
   commonAll<RandomReplacementPageCache>();
+
+  TEST_RUN(randomReplacement1);
+  TEST_RUN(randomReplacement2);
+
   return TEST_EXIT_CODE;
 }
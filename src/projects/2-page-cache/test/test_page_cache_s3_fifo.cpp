@@ -0,0 +1,70 @@
+#include "page_cache_s3_fifo.hpp"
+#include "test_page_cache_common.hpp"
+
+void s3FIFOReplacement1() {
+  S3FIFOReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(10);
+  Page *page1, *page2;
+  for (unsigned pageId = 1; pageId < 11; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  for (int i = 0; i < 2; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  pageCache.fetchPage(11, true);
+  // Page 1 was fetched again and moved to M, so page 2 should have been
+  // replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void s3FIFOReplacement2() {
+  S3FIFOReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(10);
+  Page *page1, *page2;
+  for (unsigned pageId = 1; pageId < 12; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+  // Page 1 is in G, so it enters M.
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  for (unsigned pageId = 12; pageId < 40; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void s3FIFOReplacement3() {
+  S3FIFOReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<S3FIFOReplacementPageCache>();
+
+  TEST_RUN(s3FIFOReplacement1);
+  TEST_RUN(s3FIFOReplacement2);
+  TEST_RUN(s3FIFOReplacement3);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,114 @@
+#include "page_cache_sampled.hpp"
+#include "test_page_cache_common.hpp"
+
+void sampledReplacement1() {
+  SampledReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  pageCache.fetchPage(4, true);
+  // Page 2 was unpinned least recently and should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void sampledReplacement2() {
+  SampledReplacementPageCache pageCache(
+      4096, 8, 5, SampledReplacementPageCache::scoreFrequency);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  for (int i = 0; i < 2; ++i) {
+    page3 = pageCache.fetchPage(3, true);
+    pageCache.unpinPage(page3, false);
+  }
+  pageCache.fetchPage(4, true);
+  // Page 2 was fetched least often and should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void sampledReplacement3() {
+  SampledReplacementPageCache pageCache(4096, 8);
+  pageCache.setScorer(SampledReplacementPageCache::scoreHyperbolic);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (int i = 0; i < 2; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (int i = 0; i < 20; ++i) {
+    pageCache.fetchPage(100, false);
+  }
+  for (unsigned pageId = 2; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  pageCache.fetchPage(4, true);
+  // Page 1 was fetched most often but has the lowest rate, so it should have
+  // been replaced.
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+}
+
+void sampledReplacement4() {
+  SampledReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void sampledReplacement5() {
+  bool replaced[4] = {false, false, false, false};
+  for (int i = 0; i < 100; ++i) {
+    SampledReplacementPageCache pageCache(
+        4096, 8, 5, [](const SampledReplacementPageCache::PageStats &,
+                       std::uint32_t) { return 0.0; });
+    pageCache.setMaxNumPages(3);
+    Page *page;
+    for (unsigned pageId = 1; pageId < 4; ++pageId) {
+      page = pageCache.fetchPage(pageId, true);
+      pageCache.unpinPage(page, false);
+    }
+    pageCache.fetchPage(4, true);
+    for (unsigned pageId = 1; pageId < 4; ++pageId) {
+      if (pageCache.fetchPage(pageId, false) == nullptr) {
+        replaced[pageId] = true;
+      }
+    }
+  }
+  // All scores are equal, so each page should have been replaced at least once.
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    TEST_ASSERT(replaced[pageId], "expected page to be replaced");
+  }
+}
+
+int main() {
+  commonAll<SampledReplacementPageCache>();
+
+  TEST_RUN(sampledReplacement1);
+  TEST_RUN(sampledReplacement2);
+  TEST_RUN(sampledReplacement3);
+  TEST_RUN(sampledReplacement4);
+  TEST_RUN(sampledReplacement5);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,114 @@
+#include "page_cache_sieve.hpp"
+#include "test_page_cache_common.hpp"
+
+const char *databaseName = "sieve.sqlite";
+
+void sieveReplacement1() {
+  SieveReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  pageCache.fetchPage(4, true);
+  // Page 1 was visited, so page 2 should have been replaced.
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void sieveReplacement2() {
+  SieveReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page3, *page4;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page3 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page3, false);
+  }
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page4 = pageCache.fetchPage(4, true);
+  pageCache.unpinPage(page4, false);
+  pageCache.fetchPage(5, true);
+  // The hand stayed past page 1, so page 3 should have been replaced.
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void sieveReplacement3() {
+  SieveReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+void sieveReplacement4() {
+  SieveReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(2);
+  Page *page1, *page2, *page3;
+  page1 = pageCache.fetchPage(1, true);
+  pageCache.unpinPage(page1, false);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page1 = pageCache.fetchPage(1, true);
+  // The hand passes pinned page 1 and replaces page 2.
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.unpinPage(page1, false);
+  pageCache.fetchPage(4, true);
+  // Page 1 kept its visited bit while it was pinned, so page 3 should have
+  // been replaced.
+  page3 = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page3 == nullptr, "expected null pointer");
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void sieveReplacementSQLScan() {
+  int numHits;
+  commonSQLScan<SieveReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 262, "incorrect number of hits");
+}
+
+void sieveReplacementSQLScanWithHotSet() {
+  int numHits;
+  commonSQLScanWithHotSet<SieveReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 352, "incorrect number of hits");
+}
+
+void sieveReplacementSQLUniformRandom() {
+  int numHits;
+  commonSQLUniformRandom<SieveReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 292, "incorrect number of hits");
+}
+
+void sieveReplacementSQLBinomialRandom() {
+  int numHits;
+  commonSQLBinomialRandom<SieveReplacementPageCache>(databaseName, numHits);
+  TEST_ASSERT(numHits == 298, "incorrect number of hits");
+}
+
+int main() {
+  commonAll<SieveReplacementPageCache>();
+
+  TEST_RUN(sieveReplacement1);
+  TEST_RUN(sieveReplacement2);
+  TEST_RUN(sieveReplacement3);
+  TEST_RUN(sieveReplacement4);
+
+  return TEST_EXIT_CODE;
+}
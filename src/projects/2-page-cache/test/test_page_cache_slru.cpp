@@ -0,0 +1,70 @@
+#include "page_cache_slru.hpp"
+#include "test_page_cache_common.hpp"
+
+void slruReplacement1() {
+  SLRUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2;
+  for (int i = 0; i < 2; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (unsigned pageId = 2; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 is protected and should have survived the scan.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void slruReplacement2() {
+  SLRUReplacementPageCache pageCache(4096, 8, 0.5);
+  pageCache.setMaxNumPages(4);
+  Page *page1, *page2;
+  for (int i = 0; i < 2; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  for (unsigned pageId = 2; pageId < 4; ++pageId) {
+    for (int i = 0; i < 2; ++i) {
+      page2 = pageCache.fetchPage(pageId, true);
+      pageCache.unpinPage(page2, false);
+    }
+  }
+  // The protected segment holds two pages, so page 1 was demoted to
+  // probation and should be replaced by the scan.
+  for (unsigned pageId = 4; pageId < 10; ++pageId) {
+    page2 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page2, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page1 == nullptr, "expected null pointer");
+  page2 = pageCache.fetchPage(2, false);
+  TEST_ASSERT(page2 != nullptr, "expected valid pointer");
+}
+
+void slruReplacement3() {
+  SLRUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page2, *page3;
+  pageCache.fetchPage(1, true);
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  pageCache.fetchPage(4, true);
+  page2 = pageCache.fetchPage(2, false);
+  // Page 1 is pinned, so page 2 should have been replaced.
+  TEST_ASSERT(page2 == nullptr, "expected null pointer");
+}
+
+int main() {
+  commonAll<SLRUReplacementPageCache>();
+
+  TEST_RUN(slruReplacement1);
+  TEST_RUN(slruReplacement2);
+  TEST_RUN(slruReplacement3);
+
+  return TEST_EXIT_CODE;
+}
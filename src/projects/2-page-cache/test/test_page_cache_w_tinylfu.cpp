@@ -0,0 +1,150 @@
+#include "page_cache_w_tinylfu.hpp"
+#include "test_page_cache_common.hpp"
+
+void wTinyLFUReplacement1() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  pageCache.fetchPage(4, true);
+  page = pageCache.fetchPage(3, false);
+  // Window page 3 is not more frequent than probation page 1, so page 3 should
+  // have been replaced.
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+  page = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+}
+
+void wTinyLFUReplacement2() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  for (int i = 0; i < 2; ++i) {
+    page = pageCache.fetchPage(3, true);
+    pageCache.unpinPage(page, false);
+  }
+  pageCache.fetchPage(4, true);
+  page = pageCache.fetchPage(1, false);
+  // Window page 3 is more frequent than probation page 1, so page 3 should
+  // have been admitted and page 1 replaced.
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+  page = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+}
+
+void wTinyLFUReplacementProbe() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page;
+  for (unsigned pageId = 1; pageId < 3; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // SQLite probes for a page without allocating before it allocates it. The
+  // probe and the allocation are one access.
+  for (unsigned pageId = 3; pageId < 5; ++pageId) {
+    pageCache.fetchPage(pageId, false);
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  // Window page 3 was accessed once, like probation page 1, so page 3 should
+  // have been replaced.
+  page = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+  page = pageCache.fetchPage(1, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+}
+
+void wTinyLFUReplacement3() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page1, *page2, *page3;
+  for (int i = 0; i < 3; ++i) {
+    page1 = pageCache.fetchPage(1, true);
+    pageCache.unpinPage(page1, false);
+  }
+  page2 = pageCache.fetchPage(2, true);
+  pageCache.unpinPage(page2, false);
+  page3 = pageCache.fetchPage(3, true);
+  pageCache.unpinPage(page3, false);
+  for (unsigned pageId = 4; pageId < 10; ++pageId) {
+    page3 = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page3, false);
+  }
+  page1 = pageCache.fetchPage(1, false);
+  // Page 1 is more frequent than the scanned pages and should have survived.
+  TEST_ASSERT(page1 != nullptr, "expected valid pointer");
+}
+
+void wTinyLFUReplacement4() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(100);
+  int windowTarget = pageCache.getWindowTarget();
+  Page *page;
+  for (unsigned i = 0; i < 1000; ++i) {
+    page = pageCache.fetchPage(i % 50, true);
+    pageCache.unpinPage(page, false);
+  }
+  // The hill climber should have resized the window after one sample.
+  TEST_ASSERT(pageCache.getWindowTarget() != windowTarget,
+              "expected resized window");
+}
+
+void wTinyLFUReplacementSameMaxNumPages() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(100);
+  Page *page;
+  for (unsigned i = 0; i < 1000; ++i) {
+    page = pageCache.fetchPage(i % 50, true);
+    pageCache.unpinPage(page, false);
+  }
+  int windowTarget = pageCache.getWindowTarget();
+  pageCache.setMaxNumPages(100);
+  // Setting the same maximum should not restart the hill climber.
+  TEST_ASSERT(pageCache.getWindowTarget() == windowTarget,
+              "expected unchanged window");
+}
+
+void wTinyLFUReplacementResize() {
+  WTinyLFUReplacementPageCache pageCache(4096, 8);
+  pageCache.setMaxNumPages(3);
+  Page *page;
+  for (unsigned pageId = 1; pageId < 4; ++pageId) {
+    page = pageCache.fetchPage(pageId, true);
+    pageCache.unpinPage(page, false);
+  }
+  for (int i = 0; i < 2; ++i) {
+    page = pageCache.fetchPage(3, true);
+    pageCache.unpinPage(page, false);
+  }
+  pageCache.setMaxNumPages(1000);
+  pageCache.setMaxNumPages(3);
+  pageCache.fetchPage(4, true);
+  page = pageCache.fetchPage(1, false);
+  // Resizing kept the sketch counts, so window page 3 is still more frequent
+  // than probation page 1 and page 1 should have been replaced.
+  TEST_ASSERT(page == nullptr, "expected null pointer");
+  page = pageCache.fetchPage(3, false);
+  TEST_ASSERT(page != nullptr, "expected valid pointer");
+}
+
+int main() {
+  commonAll<WTinyLFUReplacementPageCache>();
+
+  TEST_RUN(wTinyLFUReplacement1);
+  TEST_RUN(wTinyLFUReplacement2);
+  TEST_RUN(wTinyLFUReplacementProbe);
+  TEST_RUN(wTinyLFUReplacement3);
+  TEST_RUN(wTinyLFUReplacement4);
+  TEST_RUN(wTinyLFUReplacementSameMaxNumPages);
+  TEST_RUN(wTinyLFUReplacementResize);
+
+  return TEST_EXIT_CODE;
+}
@@ -0,0 +1,91 @@
+#include "page_index.hpp"
+#include "utilities/test.hpp"
+
+#include <vector>
+
+void pageIndexFind() {
+  PageIndex<int> index;
+  int pages[3];
+  TEST_ASSERT(index.find(1) == nullptr, "expected null pointer");
+  index.insert(1, &pages[0]);
+  index.insert(1000, &pages[1]);
+  // Page 4000000000 is beyond the direct-mapped range.
+  index.insert(4000000000u, &pages[2]);
+  TEST_ASSERT(index.size() == 3, "incorrect number of pages");
+  TEST_ASSERT(index.find(1) == &pages[0], "incorrect page");
+  TEST_ASSERT(index.find(1000) == &pages[1], "incorrect page");
+  TEST_ASSERT(index.find(4000000000u) == &pages[2], "incorrect page");
+  TEST_ASSERT(index.find(2) == nullptr, "expected null pointer");
+  TEST_ASSERT(index.find(100000) == nullptr, "expected null pointer");
+}
+
+void pageIndexErase() {
+  PageIndex<int> index;
+  int pages[2];
+  index.insert(1, &pages[0]);
+  index.insert(4000000000u, &pages[1]);
+  TEST_ASSERT(index.erase(1) == &pages[0], "incorrect page");
+  TEST_ASSERT(index.erase(1) == nullptr, "expected null pointer");
+  TEST_ASSERT(index.erase(4000000000u) == &pages[1], "incorrect page");
+  TEST_ASSERT(index.size() == 0, "incorrect number of pages");
+  TEST_ASSERT(index.find(1) == nullptr, "expected null pointer");
+}
+
+void pageIndexExchange() {
+  PageIndex<int> index;
+  int pages[2];
+  TEST_ASSERT(index.exchange(1, &pages[0]) == nullptr, "expected null pointer");
+  TEST_ASSERT(index.exchange(1, &pages[1]) == &pages[0], "incorrect page");
+  TEST_ASSERT(index.size() == 1, "incorrect number of pages");
+  TEST_ASSERT(index.find(1) == &pages[1], "incorrect page");
+}
+
+void pageIndexEraseFrom() {
+  PageIndex<int> index;
+  std::vector<int> pages(2000);
+  for (unsigned pageId = 1; pageId < 2000; ++pageId) {
+    index.insert(pageId, &pages[pageId]);
+  }
+  index.insert(4000000000u, &pages[0]);
+  int numErased = 0;
+  index.eraseFrom(700, [&numErased](int *) { ++numErased; });
+  // Pages 700 to 1999 and page 4000000000 should have been removed.
+  TEST_ASSERT(numErased == 1301, "incorrect number of pages removed");
+  TEST_ASSERT(index.size() == 699, "incorrect number of pages");
+  TEST_ASSERT(index.find(699) == &pages[699], "incorrect page");
+  TEST_ASSERT(index.find(700) == nullptr, "expected null pointer");
+  int numPages = 0;
+  index.forEach([&numPages](int *) { ++numPages; });
+  TEST_ASSERT(numPages == 699, "incorrect number of pages");
+}
+
+void pageIndexEraseFromSparse() {
+  PageIndex<int> index;
+  std::vector<int> pages(100001);
+  for (unsigned pageId = 1; pageId <= 100000; ++pageId) {
+    index.insert(pageId, &pages[pageId]);
+  }
+  // Page 10000000 is far past the other pages, in its own block.
+  index.insert(10000000, &pages[0]);
+  std::vector<int *> erased;
+  index.eraseFrom(99999, [&erased](int *page) { erased.push_back(page); });
+  // Pages 99999, 100000, and 10000000 should have been removed, in order.
+  TEST_ASSERT(erased.size() == 3, "incorrect number of pages removed");
+  TEST_ASSERT(erased[0] == &pages[99999], "incorrect page");
+  TEST_ASSERT(erased[1] == &pages[100000], "incorrect page");
+  TEST_ASSERT(erased[2] == &pages[0], "incorrect page");
+  TEST_ASSERT(index.size() == 99998, "incorrect number of pages");
+  index.insert(10000000, &pages[0]);
+  TEST_ASSERT(index.find(10000000) == &pages[0], "incorrect page");
+  TEST_ASSERT(index.find(99998) == &pages[99998], "incorrect page");
+}
+
+int main() {
+  TEST_RUN(pageIndexFind);
+  TEST_RUN(pageIndexErase);
+  TEST_RUN(pageIndexExchange);
+  TEST_RUN(pageIndexEraseFrom);
+  TEST_RUN(pageIndexEraseFromSparse);
+
+  return TEST_EXIT_CODE;
+}